@@ -709,6 +709,18 @@ _triggerPackageResolution(action) {
 }
 
 
+// Embedder Entrypoint:
+// The embedder calls this method to resolve the packages of the root script
+// like Isolate.packageRoot and Isolate.packageConfig do, and reads
+// _packageRoot and _packageConfig once the loader has replied.
+void _resolvePackages() {
+  if (_traceLoading) {
+    _log("Request for package resolution from the embedder.");
+  }
+  _triggerPackageResolution(() {});
+}
+
+
 Future<Uri> _getPackageRootFuture() {
   if (_traceLoading) {
     _log("Request for package root from user code.");
@@ -14,6 +14,8 @@ namespace bin {
 
 const char* kPrecompiledLibraryName = "libprecompiled.so";
 const char* kPrecompiledSymbolName = "_kInstructionsSnapshot";
+const char* kPrecompiledVmIsolateSymbolName = "_kVmIsolateSnapshot";
+const char* kPrecompiledIsolateSymbolName = "_kIsolateSnapshot";
 
 void* Extensions::LoadExtensionLibrary(const char* library_file) {
   return dlopen(library_file, RTLD_LAZY);
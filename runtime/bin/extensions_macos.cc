@@ -14,6 +14,8 @@ namespace bin {
 
 const char* kPrecompiledLibraryName = "libprecompiled.dylib";
 const char* kPrecompiledSymbolName = "kInstructionsSnapshot";
+const char* kPrecompiledVmIsolateSymbolName = "kVmIsolateSnapshot";
+const char* kPrecompiledIsolateSymbolName = "kIsolateSnapshot";
 
 void* Extensions::LoadExtensionLibrary(const char* library_file) {
   return dlopen(library_file, RTLD_LAZY);
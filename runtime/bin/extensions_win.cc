@@ -15,6 +15,8 @@ namespace bin {
 
 const char* kPrecompiledLibraryName = "precompiled.dll";
 const char* kPrecompiledSymbolName = "_kInstructionsSnapshot";
+const char* kPrecompiledVmIsolateSymbolName = "_kVmIsolateSnapshot";
+const char* kPrecompiledIsolateSymbolName = "_kIsolateSnapshot";
 
 void* Extensions::LoadExtensionLibrary(const char* library_file) {
   SetLastError(0);
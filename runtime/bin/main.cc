@@ -85,6 +85,8 @@ static bool has_noopt = false;
 
 extern const char* kPrecompiledLibraryName;
 extern const char* kPrecompiledSymbolName;
+extern const char* kPrecompiledVmIsolateSymbolName;
+extern const char* kPrecompiledIsolateSymbolName;
 static const char* kPrecompiledVmIsolateName = "precompiled.vmisolate";
 static const char* kPrecompiledIsolateName = "precompiled.isolate";
 static const char* kPrecompiledInstructionsName = "precompiled.S";
@@ -95,6 +97,19 @@ static const char* kPrecompiledInstructionsName = "precompiled.S";
 static bool has_trace_loading = false;
 
 
+// Value of the --isolate-pool-size option: the number of isolates for the
+// main script that are created and loaded ahead of spawn requests.
+static int isolate_pool_size = 0;
+
+
+// The package root or packages config the main isolate resolves 'package:'
+// URIs with, as Isolate.spawn passes them on to spawned isolates. Recorded
+// before main runs when isolates are pooled, and read-only afterwards.
+static bool main_packages_recorded = false;
+static char* main_package_root = NULL;
+static char* main_packages_config = NULL;
+
+
 static const char* DEFAULT_VM_SERVICE_SERVER_IP = "127.0.0.1";
 static const int DEFAULT_VM_SERVICE_SERVER_PORT = 8181;
 // VM Service options.
@@ -117,6 +132,9 @@ static const int kRestartRequestExitCode = 1000;
 // shutdown.
 static bool do_vm_shutdown = true;
 
+static void ShutdownIsolatePool();
+
+
 static void ErrorExit(int exit_code, const char* format, ...) {
   va_list arguments;
   va_start(arguments, format);
@@ -127,6 +145,8 @@ static void ErrorExit(int exit_code, const char* format, ...) {
   Dart_ExitScope();
   Dart_ShutdownIsolate();
 
+  ShutdownIsolatePool();
+
   // Terminate process exit-code handler.
   Process::TerminateExitCodeHandler();
 
@@ -442,6 +462,20 @@ static bool ProcessTraceLoadingOption(const char* arg,
 
 
 
+static bool ProcessIsolatePoolSizeOption(const char* arg,
+                                         CommandLineOptions* vm_options) {
+  ASSERT(arg != NULL);
+  char* end = NULL;
+  long size = strtol(arg, &end, 10);  // NOLINT
+  if ((*arg == '\0') || (*end != '\0') || (size < 0) || (size > 1024)) {
+    Log::PrintErr("--isolate-pool-size expects a number between 0 and 1024\n");
+    return false;
+  }
+  isolate_pool_size = static_cast<int>(size);
+  return true;
+}
+
+
 static bool ProcessShutdownOption(const char* arg,
                                   CommandLineOptions* vm_options) {
   ASSERT(arg != NULL);
@@ -487,6 +521,7 @@ static struct {
   { "--compile_all", ProcessCompileAllOption },
   { "--enable-vm-service", ProcessEnableVmServiceOption },
   { "--gen-precompiled-snapshot", ProcessGenPrecompiledSnapshotOption },
+  { "--isolate-pool-size=", ProcessIsolatePoolSizeOption },
   { "--noopt", ProcessNooptOption },
   { "--observe", ProcessObserveOption },
   { "--run-precompiled-snapshot", ProcessRunPrecompiledSnapshotOption },
@@ -702,6 +737,14 @@ static Dart_Handle EnvironmentCallback(Dart_Handle name) {
   }                                                                            \
 
 
+static bool StringsEqual(const char* a, const char* b) {
+  if ((a == NULL) || (b == NULL)) {
+    return a == b;
+  }
+  return strcmp(a, b) == 0;
+}
+
+
 // Returns true on success, false on failure.
 static Dart_Isolate CreateIsolateAndSetupHelper(const char* script_uri,
                                                 const char* main,
@@ -812,6 +855,204 @@ static Dart_Isolate CreateIsolateAndSetupHelper(const char* script_uri,
 #undef CHECK_RESULT
 
 
+// Isolates for the main script that a background thread creates and loads
+// ahead of time. Spawn requests for the main script with the same entry
+// point, flags and packages are handed one of them, and the thread creates a
+// replacement. As the name of an isolate includes its entry point, which the
+// embedder cannot change afterwards, the pool only serves the entry point of
+// the first spawn of the main script and starts filling up after it.
+//
+// Pooled isolates are VM isolates from the moment they are created. Until a
+// spawn takes them, they are listed by getVM, seen by the debugger and paused
+// by --pause-isolates-on-start like any other isolate.
+//
+// All of the pool state is guarded by isolate_pool_monitor. It is created in
+// main when the pool is enabled and never deleted, as isolates that are still
+// running may spawn, and so read the pool, until the process exits.
+static Monitor* isolate_pool_monitor = NULL;
+static Dart_Isolate* isolate_pool = NULL;
+static intptr_t isolate_pool_count = 0;
+static char* isolate_pool_script_uri = NULL;
+static char* isolate_pool_main = NULL;
+static Dart_IsolateFlags isolate_pool_flags;
+static bool isolate_pool_shutting_down = false;
+static bool isolate_pool_thread_running = false;
+static int64_t isolate_pool_hits = 0;
+static int64_t isolate_pool_misses = 0;
+
+
+static void IsolatePoolThreadMain(uword parameter) {
+  while (true) {
+    {
+      MonitorLocker ml(isolate_pool_monitor);
+      while (!isolate_pool_shutting_down &&
+             ((isolate_pool_main == NULL) ||
+              (isolate_pool_count >= isolate_pool_size))) {
+        ml.Wait();
+      }
+      if (isolate_pool_shutting_down) {
+        break;
+      }
+    }
+    char* error = NULL;
+    int exit_code = 0;
+    // Spawned isolates are created with the packages the main isolate
+    // resolved, which are what Isolate.spawn passes on.
+    Dart_Isolate isolate =
+        CreateIsolateAndSetupHelper(isolate_pool_script_uri,
+                                    isolate_pool_main,
+                                    main_package_root,
+                                    main_packages_config,
+                                    &isolate_pool_flags,
+                                    &error,
+                                    &exit_code);
+    if (isolate == NULL) {
+      // Leave the pool empty, spawns then create their isolates on demand.
+      Log::PrintErr("Unable to create pooled isolate: %s\n", error);
+      free(error);
+      break;
+    }
+    MonitorLocker ml(isolate_pool_monitor);
+    isolate_pool[isolate_pool_count++] = isolate;
+  }
+  MonitorLocker ml(isolate_pool_monitor);
+  isolate_pool_thread_running = false;
+  ml.NotifyAll();
+}
+
+
+// Starts the pool thread for isolates of 'script_uri', created with the
+// flags a spawn from the main isolate inherits.
+static void StartIsolatePool(const char* script_uri) {
+  ASSERT(isolate_pool_size > 0);
+  MonitorLocker ml(isolate_pool_monitor);
+  ASSERT(isolate_pool == NULL);
+  isolate_pool = new Dart_Isolate[isolate_pool_size];
+  isolate_pool_count = 0;
+  isolate_pool_script_uri = strdup(script_uri);
+  isolate_pool_main = NULL;
+  isolate_pool_flags.version = DART_FLAGS_CURRENT_VERSION;
+  isolate_pool_flags.enable_type_checks =
+      Dart_IsVMFlagSet("enable_type_checks");
+  isolate_pool_flags.enable_asserts = Dart_IsVMFlagSet("enable_asserts");
+  isolate_pool_flags.enable_error_on_bad_type =
+      Dart_IsVMFlagSet("error_on_bad_type");
+  isolate_pool_flags.enable_error_on_bad_override =
+      Dart_IsVMFlagSet("error_on_bad_override");
+  isolate_pool_shutting_down = false;
+  isolate_pool_thread_running = true;
+  int result = Thread::Start(IsolatePoolThreadMain, 0);
+  if (result != 0) {
+    Log::PrintErr("Unable to start the isolate pool thread: %d\n", result);
+    isolate_pool_thread_running = false;
+  }
+}
+
+
+static bool IsolateFlagsEqual(const Dart_IsolateFlags* a,
+                              const Dart_IsolateFlags* b) {
+  return (a->enable_type_checks == b->enable_type_checks) &&
+         (a->enable_asserts == b->enable_asserts) &&
+         (a->enable_error_on_bad_type == b->enable_error_on_bad_type) &&
+         (a->enable_error_on_bad_override == b->enable_error_on_bad_override);
+}
+
+
+// Returns a pooled isolate for the spawn request, or NULL if there is none.
+static Dart_Isolate TakePooledIsolate(const char* script_uri,
+                                      const char* main,
+                                      const char* package_root,
+                                      const char* packages_config,
+                                      Dart_IsolateFlags* flags) {
+  if (isolate_pool_size == 0) {
+    return NULL;
+  }
+  MonitorLocker ml(isolate_pool_monitor);
+  if (isolate_pool_shutting_down ||
+      !StringsEqual(script_uri, isolate_pool_script_uri)) {
+    return NULL;
+  }
+  if (!StringsEqual(package_root, main_package_root) ||
+      !StringsEqual(packages_config, main_packages_config) ||
+      !IsolateFlagsEqual(flags, &isolate_pool_flags)) {
+    isolate_pool_misses++;
+    return NULL;
+  }
+  if (isolate_pool_main == NULL) {
+    // Have the pool thread start creating isolates for this entry point.
+    isolate_pool_main = strdup(main);
+    ml.NotifyAll();
+  }
+  if ((isolate_pool_count == 0) || !StringsEqual(main, isolate_pool_main)) {
+    isolate_pool_misses++;
+    return NULL;
+  }
+  isolate_pool_hits++;
+  Dart_Isolate isolate = isolate_pool[--isolate_pool_count];
+  // Have the pool thread create a replacement.
+  ml.NotifyAll();
+  return isolate;
+}
+
+
+// Stops the pool thread and shuts down the isolates left in the pool. Must
+// be called before Dart_Cleanup, which would wait for them forever as they
+// never run.
+static void ShutdownIsolatePool() {
+  if (isolate_pool_size == 0) {
+    return;
+  }
+  Dart_Isolate* pool = NULL;
+  intptr_t count = 0;
+  {
+    MonitorLocker ml(isolate_pool_monitor);
+    // Spawns check this before anything else, so they leave the state below
+    // alone from now on.
+    isolate_pool_shutting_down = true;
+    ml.NotifyAll();
+    while (isolate_pool_thread_running) {
+      ml.Wait();
+    }
+    pool = isolate_pool;
+    count = isolate_pool_count;
+    isolate_pool = NULL;
+    isolate_pool_count = 0;
+    free(isolate_pool_script_uri);
+    isolate_pool_script_uri = NULL;
+    free(isolate_pool_main);
+    isolate_pool_main = NULL;
+  }
+  for (intptr_t i = 0; i < count; i++) {
+    Dart_EnterIsolate(pool[i]);
+    Dart_ShutdownIsolate();
+  }
+  delete[] pool;
+}
+
+
+static const char* ServiceGetIsolatePoolHandler(
+    const char* method,
+    const char** param_keys,
+    const char** param_values,
+    intptr_t num_params,
+    void* user_data) {
+  TextBuffer buffer(128);
+  if (isolate_pool_size == 0) {
+    buffer.Printf("{\"type\":\"_IsolatePool\",\"size\":%d,"
+                  "\"available\":0,\"hits\":0,\"misses\":0}",
+                  isolate_pool_size);
+    return buffer.Steal();
+  }
+  MonitorLocker ml(isolate_pool_monitor);
+  buffer.Printf("{\"type\":\"_IsolatePool\",\"size\":%d,"
+                "\"available\":%" Pd ",\"hits\":%" Pd64 ","
+                "\"misses\":%" Pd64 "}",
+                isolate_pool_size, isolate_pool_count,
+                isolate_pool_hits, isolate_pool_misses);
+  return buffer.Steal();
+}
+
+
 static Dart_Isolate CreateIsolateAndSetup(const char* script_uri,
                                           const char* main,
                                           const char* package_root,
@@ -827,6 +1068,12 @@ static Dart_Isolate CreateIsolateAndSetup(const char* script_uri,
     return NULL;
   }
 
+  Dart_Isolate isolate =
+      TakePooledIsolate(script_uri, main, package_root, package_config, flags);
+  if (isolate != NULL) {
+    return isolate;
+  }
+
   int exit_code = 0;
   return CreateIsolateAndSetupHelper(script_uri,
                                      main,
@@ -896,6 +1143,10 @@ static void PrintUsage() {
 "--trace-loading\n"
 "  enables tracing of library and script loading\n"
 "\n"
+"--isolate-pool-size=<count>\n"
+"  keeps <count> isolates for the main script created and loaded ahead of\n"
+"  Isolate.spawn requests, for the entry point of the first spawn\n"
+"\n"
 "--enable-vm-service[:<port>[/<bind-address>]]\n"
 "  enables the VM service and listens on specified port for connections\n"
 "  (default port number is 8181, default bind address is 127.0.0.1).\n"
@@ -1048,6 +1299,66 @@ static void WritePrecompiledSnapshotFile(const char* filename,
 }
 
 
+// Appends [buffer] to the assembly in [assembly] as read-only data labeled
+// with [symbol], so that the shared library built from the assembly carries
+// the snapshot and the embedder does not need to read it from a file.
+static void AppendSnapshotDataAssembly(TextBuffer* assembly,
+                                       const char* symbol,
+                                       const uint8_t* buffer,
+                                       intptr_t size) {
+#if defined(TARGET_OS_MACOS)
+  assembly->Printf(".const\n");
+#else
+  assembly->Printf(".section .rodata\n");
+#endif
+  assembly->Printf(".globl %s\n", symbol);
+  assembly->Printf(".balign 64, 0\n");
+  assembly->Printf("%s:\n", symbol);
+  static const char kHexDigits[] = "0123456789abcdef";
+  static const intptr_t kBytesPerLine = 16;
+  // ".byte " followed by up to 16 entries of "0xNN," and a newline.
+  char line[6 + kBytesPerLine * 5 + 1];
+  for (intptr_t i = 0; i < size; i += kBytesPerLine) {
+    intptr_t pos = 0;
+    memmove(&line[pos], ".byte ", 6);
+    pos += 6;
+    for (intptr_t j = i; (j < size) && (j < i + kBytesPerLine); j++) {
+      if (j > i) {
+        line[pos++] = ',';
+      }
+      line[pos++] = '0';
+      line[pos++] = 'x';
+      line[pos++] = kHexDigits[buffer[j] >> 4];
+      line[pos++] = kHexDigits[buffer[j] & 0xf];
+    }
+    line[pos++] = '\n';
+    line[pos] = '\0';
+    assembly->AddString(line);
+  }
+}
+
+
+static void WritePrecompiledAssemblyFile(const uint8_t* instructions_buffer,
+                                         intptr_t instructions_size,
+                                         const uint8_t* vm_isolate_buffer,
+                                         intptr_t vm_isolate_size,
+                                         const uint8_t* isolate_buffer,
+                                         intptr_t isolate_size) {
+  TextBuffer assembly(instructions_size + 6 * (vm_isolate_size + isolate_size));
+  assembly.Printf("%.*s", static_cast<int>(instructions_size),
+                  reinterpret_cast<const char*>(instructions_buffer));
+  // Symbols are written with the leading underscore expected by the
+  // assembler, see kPrecompiledSymbolName.
+  AppendSnapshotDataAssembly(&assembly, "_kVmIsolateSnapshot",
+                             vm_isolate_buffer, vm_isolate_size);
+  AppendSnapshotDataAssembly(&assembly, "_kIsolateSnapshot",
+                             isolate_buffer, isolate_size);
+  WritePrecompiledSnapshotFile(kPrecompiledInstructionsName,
+                               reinterpret_cast<const uint8_t*>(assembly.buf()),
+                               assembly.length());
+}
+
+
 static void ReadPrecompiledSnapshotFile(const char* filename,
                                         const uint8_t** buffer) {
   char* concat = NULL;
@@ -1082,12 +1393,17 @@ static void ReadPrecompiledSnapshotFile(const char* filename,
 }
 
 
-static void* LoadLibrarySymbol(const char* libname, const char* symname) {
+static void* LoadPrecompiledLibrary(const char* libname) {
   void* library = Extensions::LoadExtensionLibrary(libname);
   if (library == NULL) {
     Log::PrintErr("Error: Failed to load library '%s'\n", libname);
     Platform::Exit(kErrorExitCode);
   }
+  return library;
+}
+
+
+static void* LoadLibrarySymbol(void* library, const char* symname) {
   void* symbol = Extensions::ResolveSymbol(library, symname);
   if (symbol == NULL) {
     Log::PrintErr("Error: Failed to load symbol '%s'\n", symname);
@@ -1125,6 +1441,49 @@ static void GenerateScriptSnapshot() {
 }
 
 
+// Returns a copy of the URI in the builtin library field 'name', or NULL if
+// the field is null.
+static char* GetBuiltinUriField(Dart_Handle builtin_lib, const char* name) {
+  Dart_Handle uri = Dart_GetField(builtin_lib, DartUtils::NewString(name));
+  if (Dart_IsError(uri) || Dart_IsNull(uri)) {
+    return NULL;
+  }
+  const char* uri_chars = NULL;
+  Dart_Handle result = Dart_StringToCString(Dart_ToString(uri), &uri_chars);
+  if (Dart_IsError(result)) {
+    return NULL;
+  }
+  return strdup(uri_chars);
+}
+
+
+// Resolves the packages of the main isolate the way Isolate.spawn does and
+// records them. Returns false if they could not be resolved, in which case
+// spawned isolates never match the main isolate's packages.
+static bool RecordMainIsolatePackages() {
+  Dart_Handle builtin_lib =
+      Builtin::LoadAndCheckLibrary(Builtin::kBuiltinLibrary);
+  Dart_Handle result = Dart_Invoke(builtin_lib,
+                                   DartUtils::NewString("_resolvePackages"),
+                                   0,
+                                   NULL);
+  if (!Dart_IsError(result)) {
+    // Wait for the loader's reply if the packages were not resolved yet.
+    result = Dart_RunLoop();
+  }
+  if (Dart_IsError(result)) {
+    if (has_trace_loading) {
+      Log::PrintErr("Unable to resolve the main isolate's packages: %s\n",
+                    Dart_GetError(result));
+    }
+    return false;
+  }
+  main_package_root = GetBuiltinUriField(builtin_lib, "_packageRoot");
+  main_packages_config = GetBuiltinUriField(builtin_lib, "_packageConfig");
+  return true;
+}
+
+
 #define CHECK_RESULT(result)                                                   \
   if (Dart_IsError(result)) {                                                  \
     if (Dart_IsVMRestartRequest(result)) {                                     \
@@ -1184,6 +1543,10 @@ bool RunMainIsolate(const char* script_name,
   if (generate_script_snapshot) {
     GenerateScriptSnapshot();
   } else {
+    if (isolate_pool_size > 0) {
+      main_packages_recorded = RecordMainIsolatePackages();
+    }
+
     // Lookup the library of the root script.
     Dart_Handle root_lib = Dart_RootLibrary();
     // Import the root library into the builtin library so that we can easily
@@ -1219,6 +1582,7 @@ bool RunMainIsolate(const char* script_name,
         { "dart:_builtin", "::", "_setWorkingDirectory" },
         { "dart:_builtin", "::", "_setPackageRoot" },
         { "dart:_builtin", "::", "_loadPackagesMap" },
+        { "dart:_builtin", "::", "_resolvePackages" },
         { "dart:_builtin", "::", "_loadDataAsync" },
         { "dart:io", "::", "_makeUint8ListView" },
         { "dart:io", "::", "_makeDatagram" },
@@ -1269,9 +1633,12 @@ bool RunMainIsolate(const char* script_name,
       WritePrecompiledSnapshotFile(kPrecompiledIsolateName,
                                    isolate_buffer,
                                    isolate_size);
-      WritePrecompiledSnapshotFile(kPrecompiledInstructionsName,
-                                   instructions_buffer,
-                                   instructions_size);
+      WritePrecompiledAssemblyFile(instructions_buffer,
+                                   instructions_size,
+                                   vm_isolate_buffer,
+                                   vm_isolate_size,
+                                   isolate_buffer,
+                                   isolate_size);
     } else {
       if (Dart_IsNull(root_lib)) {
         ErrorExit(kErrorExitCode,
@@ -1279,6 +1646,13 @@ bool RunMainIsolate(const char* script_name,
                   script_name);
       }
 
+      if ((isolate_pool_size > 0) && main_packages_recorded) {
+        const char* root_uri = NULL;
+        result = Dart_StringToCString(Dart_LibraryUrl(root_lib), &root_uri);
+        CHECK_RESULT(result);
+        StartIsolatePool(root_uri);
+      }
+
       // The helper function _getMainClosure creates a closure for the main
       // entry point which is either explicitly or implictly exported from the
       // root library.
@@ -1449,6 +1823,10 @@ void main(int argc, char** argv) {
 
   Thread::InitOnce();
 
+  if (isolate_pool_size > 0) {
+    isolate_pool_monitor = new Monitor();
+  }
+
   if (!DartUtils::SetOriginalWorkingDirectory()) {
     OSError err;
     fprintf(stderr, "Error determining current directory: %s\n", err.message());
@@ -1468,12 +1846,22 @@ void main(int argc, char** argv) {
 
   const uint8_t* instructions_snapshot = NULL;
   if (has_run_precompiled_snapshot) {
+    void* library = LoadPrecompiledLibrary(kPrecompiledLibraryName);
     instructions_snapshot = reinterpret_cast<const uint8_t*>(
-        LoadLibrarySymbol(kPrecompiledLibraryName, kPrecompiledSymbolName));
-    ReadPrecompiledSnapshotFile(kPrecompiledVmIsolateName,
-                                &vm_isolate_snapshot_buffer);
-    ReadPrecompiledSnapshotFile(kPrecompiledIsolateName,
-                                &isolate_snapshot_buffer);
+        LoadLibrarySymbol(library, kPrecompiledSymbolName));
+    // Libraries built from newer assembly files also carry the snapshots in
+    // their read-only data, which lets all processes share their pages.
+    vm_isolate_snapshot_buffer = reinterpret_cast<const uint8_t*>(
+        Extensions::ResolveSymbol(library, kPrecompiledVmIsolateSymbolName));
+    isolate_snapshot_buffer = reinterpret_cast<const uint8_t*>(
+        Extensions::ResolveSymbol(library, kPrecompiledIsolateSymbolName));
+    if ((vm_isolate_snapshot_buffer == NULL) ||
+        (isolate_snapshot_buffer == NULL)) {
+      ReadPrecompiledSnapshotFile(kPrecompiledVmIsolateName,
+                                  &vm_isolate_snapshot_buffer);
+      ReadPrecompiledSnapshotFile(kPrecompiledIsolateName,
+                                  &isolate_snapshot_buffer);
+    }
   }
 
   // Initialize the Dart VM.
@@ -1498,14 +1886,20 @@ void main(int argc, char** argv) {
 
   Dart_RegisterIsolateServiceRequestCallback(
         "getIO", &ServiceGetIOHandler, NULL);
+  Dart_RegisterRootServiceRequestCallback(
+        "_getIsolatePool", &ServiceGetIsolatePoolHandler, NULL);
   Dart_SetServiceStreamCallbacks(&ServiceStreamListenCallback,
                                  &ServiceStreamCancelCallback);
 
   // Run the main isolate until we aren't told to restart.
   while (RunMainIsolate(script_name, &dart_options)) {
+    ShutdownIsolatePool();
     Log::PrintErr("Restarting VM\n");
   }
 
+  // Pooled isolates never run, so they have to be shut down before cleanup.
+  ShutdownIsolatePool();
+
   // Terminate process exit-code handler.
   Process::TerminateExitCodeHandler();
 
@@ -0,0 +1,52 @@
+// Copyright (c) 2016, the Dart project authors.  Please see the AUTHORS file
+// for details. All rights reserved. Use of this source code is governed by a
+// BSD-style license that can be found in the LICENSE file.
+// VMOptions=--error_on_bad_type --error_on_bad_override --compiler_profile
+
+library get_compiler_profile_rpc_test;
+
+import 'package:observatory/service_io.dart';
+import 'package:unittest/unittest.dart';
+
+import 'test_helper.dart';
+
+int fib(int n) => (n < 2) ? n : fib(n - 1) + fib(n - 2);
+
+void warmup() {
+  fib(20);
+}
+
+var tests = [
+  (Isolate isolate) async {
+    var result = await isolate.invokeRpcNoUpgrade('_getCompilerProfile', {});
+    expect(result['type'], equals('_CompilerProfile'));
+    expect(result['enabled'], isTrue);
+    var members = result['members'];
+    expect(members, isList);
+    expect(members.length, equals(result['totalFunctions']));
+    expect(members.length, greaterThan(0));
+    var previousTime;
+    for (var member in members) {
+      expect(member['type'], equals('_CompilerProfileEntry'));
+      expect(member['function']['type'], equals('@Function'));
+      expect(member['compilations'], greaterThan(0));
+      expect(member['compileTime'], greaterThanOrEqualTo(0));
+      expect(member['ilInstructionCount'], greaterThan(0));
+      if (previousTime != null) {
+        expect(member['compileTime'], lessThanOrEqualTo(previousTime));
+      }
+      previousTime = member['compileTime'];
+    }
+    var fibEntries = members.where((m) => m['function']['name'] == 'fib');
+    expect(fibEntries.length, equals(1));
+  },
+
+  (Isolate isolate) async {
+    var result = await isolate.invokeRpcNoUpgrade('_getCompilerProfile',
+                                                  { 'limit': 1 });
+    expect(result['type'], equals('_CompilerProfile'));
+    expect(result['members'].length, equals(1));
+  },
+];
+
+main(args) async => runIsolateTests(args, tests, testeeBefore:warmup);
@@ -0,0 +1,75 @@
+// Copyright (c) 2016, the Dart project authors.  Please see the AUTHORS file
+// for details. All rights reserved. Use of this source code is governed by a
+// BSD-style license that can be found in the LICENSE file.
+// VMOptions=--error_on_bad_type --error_on_bad_override --isolate-pool-size=2
+
+import 'dart:async';
+import 'dart:isolate' as I;
+import 'package:observatory/service_io.dart';
+import 'package:unittest/unittest.dart';
+
+import 'test_helper.dart';
+
+// Stays alive so that the test can look up its name.
+void child(I.SendPort replyPort) {
+  var port = new I.ReceivePort();
+  replyPort.send(port.sendPort);
+}
+
+Future spawnChild() async {
+  var port = new I.ReceivePort();
+  await I.Isolate.spawn(child, port.sendPort);
+  await port.first;
+}
+
+Future<Map> getIsolatePool(VM vm) =>
+    vm.invokeRpcNoUpgrade('_getIsolatePool', {});
+
+// Polls the pool until 'condition' holds for it.
+Future<Map> waitForIsolatePool(VM vm, bool condition(Map pool)) async {
+  while (true) {
+    var result = await getIsolatePool(vm);
+    if (condition(result)) {
+      return result;
+    }
+    await new Future.delayed(const Duration(milliseconds: 100));
+  }
+}
+
+var tests = [
+  (Isolate isolate) async {
+    VM vm = isolate.vm;
+    var result = await getIsolatePool(vm);
+    expect(result['type'], equals('_IsolatePool'));
+    expect(result['size'], equals(2));
+    // Nothing was spawned yet, so the pool does not know the entry point.
+    expect(result['available'], equals(0));
+    expect(result['hits'], equals(0));
+    expect(result['misses'], equals(0));
+
+    // The first spawn misses and has the pool fill up for 'child'.
+    Library rootLib = await isolate.rootLibrary.load();
+    await rootLib.evaluate('spawnChild()');
+    result = await waitForIsolatePool(vm, (pool) => pool['misses'] == 1);
+    expect(result['hits'], equals(0));
+    await waitForIsolatePool(vm, (pool) => pool['available'] == 2);
+
+    // The second spawn is handed a pooled isolate.
+    await rootLib.evaluate('spawnChild()');
+    result = await waitForIsolatePool(vm, (pool) => pool['hits'] == 1);
+    expect(result['misses'], equals(1));
+  },
+
+  (Isolate isolate) async {
+    // Pooled isolates are named after the entry point they run. The ones not
+    // handed out yet are listed as well, next to the two spawned children.
+    VM vm = isolate.vm;
+    await waitForIsolatePool(vm, (pool) => pool['available'] == 2);
+    await vm.reload();
+    var names = vm.isolates.map((isolate) => isolate.name).toList();
+    expect(names.where((name) => name.endsWith(':main')).length, equals(1));
+    expect(names.where((name) => name.endsWith(':child')).length, equals(4));
+  },
+];
+
+main(args) async => runIsolateTests(args, tests);
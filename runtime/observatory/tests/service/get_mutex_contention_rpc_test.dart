@@ -0,0 +1,76 @@
+// Copyright (c) 2016, the Dart project authors.  Please see the AUTHORS file
+// for details. All rights reserved. Use of this source code is governed by a
+// BSD-style license that can be found in the LICENSE file.
+// VMOptions=--error_on_bad_type --error_on_bad_override --profile_mutex_contention
+
+import 'dart:async';
+import 'dart:isolate';
+import 'package:observatory/service_io.dart';
+import 'package:unittest/unittest.dart';
+
+import 'test_helper.dart';
+
+// Replies to every message with its own port, so that the main isolate
+// sends the next one. Each message posted takes the port map lock.
+void echo(SendPort replyPort) {
+  var port = new ReceivePort();
+  port.listen((_) => replyPort.send(port.sendPort));
+  replyPort.send(port.sendPort);
+}
+
+// Keeps several isolates sending messages to each other until the testee is
+// killed.
+Future startEchoes() async {
+  var port = new ReceivePort();
+  port.listen((SendPort echoPort) => echoPort.send(null));
+  for (var i = 0; i < 4; i++) {
+    Isolate.spawn(echo, port.sendPort);
+  }
+}
+
+// Number of times the test polls for contention, 100ms apart.
+const kMaxAttempts = 100;
+
+var tests = [
+  (VM vm) async {
+    var result;
+    // Wait until the echoing isolates have contended for a lock.
+    for (var attempt = 0; attempt < kMaxAttempts; attempt++) {
+      result = await vm.invokeRpcNoUpgrade('_getMutexContention', {});
+      expect(result['type'], equals('_MutexContention'));
+      expect(result['enabled'], isTrue);
+      if (result['sites'].isNotEmpty) {
+        break;
+      }
+      await new Future.delayed(const Duration(milliseconds: 100));
+    }
+    if (result['sites'].isEmpty) {
+      fail('No contended lock was reported after $kMaxAttempts attempts.');
+    }
+    var sites = result['sites'];
+    expect(sites, new isInstanceOf<List>());
+    expect(sites, isNotEmpty);
+    var lastWait;
+    for (var site in sites) {
+      expect(site['name'], new isInstanceOf<String>());
+      expect(site['contendedCount'], greaterThan(0));
+      expect(site['waitTimeHistogram'].length, equals(16));
+      // Sites are sorted by total wait time, most contended first.
+      if (lastWait != null) {
+        expect(site['waitMicros'], lessThanOrEqualTo(lastWait));
+      }
+      lastWait = site['waitMicros'];
+    }
+  },
+
+  (VM vm) async {
+    var params = {
+      'limit': 1,
+    };
+    var result = await vm.invokeRpcNoUpgrade('_getMutexContention', params);
+    expect(result['type'], equals('_MutexContention'));
+    expect(result['sites'].length, equals(1));
+  },
+];
+
+main(args) async => runVMTests(args, tests, testeeConcurrent: startEchoes);
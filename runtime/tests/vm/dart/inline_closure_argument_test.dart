@@ -0,0 +1,63 @@
+// Copyright (c) 2016, the Dart project authors.  Please see the AUTHORS file
+// for details. All rights reserved. Use of this source code is governed by a
+// BSD-style license that can be found in the LICENSE file.
+
+// VMOptions=--optimization_counter_threshold=10 --no-use-osr
+
+// Test inlining of higher-order callees that are passed a closure literal,
+// and direct calls of known closures that are not inlined.
+
+import "package:expect/expect.dart";
+
+class Box {
+  var value;
+  Box(this.value);
+}
+
+int sumForEach(List<int> list) {
+  var sum = 0;
+  list.forEach((e) { sum += e; });
+  return sum;
+}
+
+int sumNamed(List<int> list) {
+  var box = new Box(0);
+  apply(list, f: (e) => box.value += e);
+  return box.value;
+}
+
+apply(List list, {f}) {
+  for (var i = 0; i < list.length; i++) f(list[i]);
+}
+
+// Too large to be inlined; its call through a known closure stays a call.
+int big(int x) {
+  var r = x;
+  for (var i = 0; i < 3; i++) {
+    r = (r * 31 + i) % 1000003;
+    r = (r ^ 0x5a5a) % 1000003;
+    r = (r + x * i) % 1000003;
+    if (r.isEven) r = r ~/ 2; else r = r * 3 + 1;
+    r = r % 1000003;
+  }
+  return r;
+}
+
+int callBig(int x) {
+  var f = big;
+  var g = (y) => f(y) + 1;
+  return g(x);
+}
+
+main() {
+  var list = [1, 2, 3, 4, 5];
+  for (var i = 0; i < 50; i++) {
+    Expect.equals(15, sumForEach(list));
+    Expect.equals(15, sumNamed(list));
+    Expect.equals(big(i) + 1, callBig(i));
+  }
+  // Different closure shapes after optimization.
+  Expect.equals(0, sumForEach([]));
+  Expect.equals(-3, sumNamed([-1, -2]));
+  Expect.throws(() => sumForEach([1, null]));
+}
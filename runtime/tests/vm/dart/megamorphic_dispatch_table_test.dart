@@ -0,0 +1,51 @@
+// Copyright (c) 2016, the Dart project authors.  Please see the AUTHORS file
+// for details. All rights reserved. Use of this source code is governed by a
+// BSD-style license that can be found in the LICENSE file.
+
+// VMOptions=--use_dispatch_table
+
+// Test megamorphic calls through the dispatch table. When the test is
+// precompiled, the call in callFoo becomes megamorphic: receivers of classes
+// that implement 'foo' find their target in the table, the others fall back
+// to probing the megamorphic cache and end up in noSuchMethod.
+
+import "package:expect/expect.dart";
+
+class A {
+  foo() => 'A.foo';
+}
+
+class B extends A {
+  foo() => 'B.foo';
+}
+
+class C extends A {}
+
+class D {
+  foo() => 'D.foo';
+}
+
+class E {
+  foo() => 'E.foo';
+}
+
+class F extends D {}
+
+class G {
+  noSuchMethod(invocation) => 'G.noSuchMethod';
+}
+
+callFoo(x) => x.foo();
+
+main() {
+  var receivers = [new A(), new B(), new C(), new D(), new E(), new F(),
+                   new G()];
+  var expected = ['A.foo', 'B.foo', 'A.foo', 'D.foo', 'E.foo', 'D.foo',
+                  'G.noSuchMethod'];
+  for (var i = 0; i < 20; i++) {
+    for (var j = 0; j < receivers.length; j++) {
+      Expect.equals(expected[j], callFoo(receivers[j]));
+    }
+    Expect.throws(() => callFoo(42), (e) => e is NoSuchMethodError);
+  }
+}
@@ -0,0 +1,42 @@
+// Copyright (c) 2016, the Dart project authors.  Please see the AUTHORS file
+// for details. All rights reserved. Use of this source code is governed by a
+// BSD-style license that can be found in the LICENSE file.
+
+// Test the output of --print_precompiled_fingerprints. The precompiler only
+// runs in-process with --noopt, otherwise there is nothing to check.
+
+import "dart:io";
+import "package:expect/expect.dart";
+
+fingerprintedFunction(x) => x + 1;
+
+main(List<String> args) {
+  if (args.contains('--child')) {
+    print(fingerprintedFunction(41));
+    return;
+  }
+  if (!Platform.executableArguments.contains('--noopt')) {
+    return;
+  }
+  var result = Process.runSync(Platform.executable,
+      []..addAll(Platform.executableArguments)
+        ..add('--print_precompiled_fingerprints')
+        ..add(Platform.script.toFilePath())
+        ..add('--child'));
+  print("=== stdout ===\n ${result.stdout}");
+  print("=== stderr ===\n ${result.stderr}");
+  Expect.equals(0, result.exitCode);
+
+  var lines = result.stdout.split('\n');
+  Expect.isTrue(lines.first.startsWith('# snapshot '));
+  var functionLine = new RegExp(r'^[0-9a-f]{8} [0-9]+ ');
+  var found = false;
+  for (var line in lines.skip(1)) {
+    if (line.isEmpty || line == '42') continue;
+    Expect.isTrue(functionLine.hasMatch(line), line);
+    if (line.endsWith('fingerprintedFunction')) {
+      found = true;
+    }
+  }
+  Expect.isTrue(found);
+}
@@ -0,0 +1,49 @@
+// Copyright (c) 2016, the Dart project authors.  Please see the AUTHORS file
+// for details. All rights reserved. Use of this source code is governed by a
+// BSD-style license that can be found in the LICENSE file.
+
+// VMOptions=--precompiler_rounds=2 --collect_dynamic_function_names
+
+// Test that the precompiler only treats a method as a unique dynamic target
+// when no subclass overriding it was allocated in the previous round. The
+// flags only have an effect when the test is precompiled.
+
+import "package:expect/expect.dart";
+
+class A {
+  foo() => 'A.foo';
+}
+
+// Never allocated: A.foo is the unique target of 'foo' in the second round
+// and this override is dropped.
+class B extends A {
+  foo() => 'B.foo';
+}
+
+class C {
+  bar() => 'C.bar';
+}
+
+// Only allocated by a method reached through a dynamic call, so the first
+// round finds it after it has processed the calls of 'bar'. C.bar must not be
+// treated as the unique target of 'bar'.
+class D extends C {
+  bar() => 'D.bar';
+}
+
+class Factory {
+  makeD() => new D();
+}
+
+callFoo(x) => x.foo();
+
+callBar(x) => x.bar();
+
+main() {
+  var factory = [new Factory()][0];
+  for (var i = 0; i < 20; i++) {
+    Expect.equals('A.foo', callFoo(new A()));
+    Expect.equals('C.bar', callBar(new C()));
+    Expect.equals('D.bar', callBar(factory.makeD()));
+  }
+}
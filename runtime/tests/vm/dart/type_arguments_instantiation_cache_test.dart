@@ -0,0 +1,48 @@
+// Copyright (c) 2016, the Dart project authors.  Please see the AUTHORS file
+// for details. All rights reserved. Use of this source code is governed by a
+// BSD-style license that can be found in the LICENSE file.
+// VMOptions=--optimization_counter_threshold=10 --no-use-osr
+
+// Test that instantiating the same generic type argument vector from more
+// instantiators than fit in the linear part of the instantiations cache keeps
+// returning the correct instantiation.
+
+import "package:expect/expect.dart";
+
+class A<T> {
+  makeList() => new List<T>();
+}
+
+class C0 {}
+class C1 {}
+class C2 {}
+class C3 {}
+class C4 {}
+class C5 {}
+class C6 {}
+class C7 {}
+class C8 {}
+class C9 {}
+class C10 {}
+class C11 {}
+
+final instances = [
+  new A<C0>(), new A<C1>(), new A<C2>(), new A<C3>(),
+  new A<C4>(), new A<C5>(), new A<C6>(), new A<C7>(),
+  new A<C8>(), new A<C9>(), new A<C10>(), new A<C11>(),
+];
+
+final expected = [
+  new List<C0>(), new List<C1>(), new List<C2>(), new List<C3>(),
+  new List<C4>(), new List<C5>(), new List<C6>(), new List<C7>(),
+  new List<C8>(), new List<C9>(), new List<C10>(), new List<C11>(),
+];
+
+main() {
+  for (int iteration = 0; iteration < 20; iteration++) {
+    for (int i = 0; i < instances.length; i++) {
+      var list = instances[i].makeList();
+      Expect.equals(expected[i].runtimeType, list.runtimeType);
+    }
+  }
+}
@@ -2364,6 +2364,18 @@ void Assembler::bsrq(Register dst, Register src) {
 }
 
 
+void Assembler::lzcntq(Register dst, Register src) {
+  ASSERT(TargetCPUFeatures::lzcnt_supported());
+  AssemblerBuffer::EnsureCapacity ensured(&buffer_);
+  Operand operand(src);
+  EmitUint8(0xF3);
+  EmitOperandREX(dst, operand, REX_W);
+  EmitUint8(0x0F);
+  EmitUint8(0xBD);
+  EmitOperand(dst & 7, operand);
+}
+
+
 void Assembler::btq(Register base, Register offset) {
   AssemblerBuffer::EnsureCapacity ensured(&buffer_);
   Operand operand(base);
@@ -648,6 +648,7 @@ class Assembler : public ValueObject {
   void notq(Register reg);
 
   void bsrq(Register dst, Register src);
+  void lzcntq(Register dst, Register src);
 
   void btq(Register base, Register offset);
 
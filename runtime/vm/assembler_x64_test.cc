@@ -6,6 +6,8 @@
 #if defined(TARGET_ARCH_X64)
 
 #include "vm/assembler.h"
+#include "vm/cpu.h"
+#include "vm/intrinsifier.h"
 #include "vm/os.h"
 #include "vm/unit_test.h"
 #include "vm/virtual_memory.h"
@@ -656,6 +658,87 @@ ASSEMBLER_TEST_RUN(BitScanReverse, test) {
 }
 
 
+ASSEMBLER_TEST_GENERATE(LeadingZeroCount, assembler) {
+  if (TargetCPUFeatures::lzcnt_supported()) {
+    __ lzcntq(RAX, CallingConventions::kArg1Reg);
+  }
+  __ ret();
+}
+
+
+ASSEMBLER_TEST_RUN(LeadingZeroCount, test) {
+  if (TargetCPUFeatures::lzcnt_supported()) {
+    typedef int64_t (*Lzcnt)(int64_t input);
+    Lzcnt call = reinterpret_cast<Lzcnt>(test->entry());
+    EXPECT_EQ(64, call(0));
+    EXPECT_EQ(63, call(1));
+    EXPECT_EQ(62, call(2));
+    EXPECT_EQ(58, call(42));
+    EXPECT_EQ(0, call(-1));
+  }
+}
+
+
+class IntrinsifierTestPeer : public AllStatic {
+ public:
+  static void Smi_bitLength(Assembler* assembler) {
+    Intrinsifier::Smi_bitLength(assembler);
+  }
+};
+
+
+// Calls the Smi.bitLength intrinsic with the Smi passed in the first argument
+// register as its receiver on the stack.
+static void GenerateSmiBitLengthCall(Assembler* assembler) {
+  Label intrinsic;
+  __ pushq(CallingConventions::kArg1Reg);
+  __ call(&intrinsic);
+  __ popq(RCX);
+  __ ret();
+  __ Bind(&intrinsic);
+  IntrinsifierTestPeer::Smi_bitLength(assembler);
+}
+
+
+static void CheckSmiBitLength(const AssemblerTest* test) {
+  typedef int64_t (*BitLength)(int64_t smi);
+  BitLength call = reinterpret_cast<BitLength>(test->entry());
+  EXPECT_EQ(Smi::RawValue(0), call(Smi::RawValue(0)));
+  EXPECT_EQ(Smi::RawValue(1), call(Smi::RawValue(1)));
+  EXPECT_EQ(Smi::RawValue(2), call(Smi::RawValue(2)));
+  EXPECT_EQ(Smi::RawValue(6), call(Smi::RawValue(42)));
+  EXPECT_EQ(Smi::RawValue(0), call(Smi::RawValue(-1)));
+  EXPECT_EQ(Smi::RawValue(1), call(Smi::RawValue(-2)));
+  EXPECT_EQ(Smi::RawValue(6), call(Smi::RawValue(-43)));
+  EXPECT_EQ(Smi::RawValue(62), call(Smi::RawValue(Smi::kMaxValue)));
+  EXPECT_EQ(Smi::RawValue(62), call(Smi::RawValue(Smi::kMinValue)));
+}
+
+
+ASSEMBLER_TEST_GENERATE(SmiBitLength, assembler) {
+  GenerateSmiBitLengthCall(assembler);
+}
+
+
+ASSEMBLER_TEST_RUN(SmiBitLength, test) {
+  CheckSmiBitLength(test);
+}
+
+
+// The BSR sequence used without LZCNT and when precompiling.
+ASSEMBLER_TEST_GENERATE(SmiBitLengthBsr, assembler) {
+  const bool use_lzcnt = FLAG_use_lzcnt;
+  FLAG_use_lzcnt = false;
+  GenerateSmiBitLengthCall(assembler);
+  FLAG_use_lzcnt = use_lzcnt;
+}
+
+
+ASSEMBLER_TEST_RUN(SmiBitLengthBsr, test) {
+  CheckSmiBitLength(test);
+}
+
+
 ASSEMBLER_TEST_GENERATE(MoveExtend, assembler) {
   __ movq(RDX, Immediate(0xffff));
   __ movzxb(RAX, RDX);  // RAX = 0xff
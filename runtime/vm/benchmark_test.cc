@@ -521,6 +521,56 @@ BENCHMARK(FrameLookup) {
 }
 
 
+//
+// Measure throughput of throwing and catching exceptions, with and without
+// the handler asking for the stack trace.
+//
+BENCHMARK(ThrowCatch) {
+  const int kNumIterations = 100000;
+  const char* kScriptChars =
+      "class ParseException {\n"
+      "  final int position;\n"
+      "  ParseException(this.position);\n"
+      "}\n"
+      "int parse(int depth, int position) {\n"
+      "  if (depth == 0) throw new ParseException(position);\n"
+      "  return parse(depth - 1, position);\n"
+      "}\n"
+      "int benchmark(int count) {\n"
+      "  int sum = 0;\n"
+      "  for (int i = 0; i < count; i++) {\n"
+      "    try {\n"
+      "      sum += parse(10, i);\n"
+      "    } on ParseException catch (e) {\n"
+      "      sum += e.position;\n"
+      "    }\n"
+      "    try {\n"
+      "      sum += parse(10, i);\n"
+      "    } on ParseException catch (e, s) {\n"
+      "      sum += e.position;\n"
+      "    }\n"
+      "  }\n"
+      "  return sum;\n"
+      "}\n";
+  Dart_Handle lib = TestCase::LoadTestScript(kScriptChars, NULL);
+
+  Dart_Handle args[1];
+  args[0] = Dart_NewInteger(kNumIterations);
+
+  // Warmup first to avoid compilation jitters.
+  Dart_Handle result = Dart_Invoke(lib, NewString("benchmark"), 1, args);
+  EXPECT_VALID(result);
+
+  Timer timer(true, "ThrowCatch benchmark");
+  timer.Start();
+  result = Dart_Invoke(lib, NewString("benchmark"), 1, args);
+  timer.Stop();
+  EXPECT_VALID(result);
+  int64_t elapsed_time = timer.TotalElapsedTime();
+  benchmark->set_score(elapsed_time);
+}
+
+
 static uint8_t* malloc_allocator(
     uint8_t* ptr, intptr_t old_size, intptr_t new_size) {
   return reinterpret_cast<uint8_t*>(realloc(ptr, new_size));
@@ -11,6 +11,8 @@
 namespace dart {
 
 DEFINE_FLAG(bool, emit_edge_counters, true, "Emit edge counters at targets.");
+DEFINE_FLAG(bool, move_cold_blocks, true,
+    "Emit cold blocks after all hot blocks of an optimized function.");
 
 static intptr_t GetEdgeCount(const Array& edge_counters, intptr_t edge_id) {
   if (!FLAG_emit_edge_counters) {
@@ -148,6 +150,19 @@ static void Union(GrowableArray<Chain*>* chains,
 }
 
 
+// A block is cold if it is only entered when an exception is thrown or if it
+// unconditionally leaves the function by throwing.  Edge weights are not used
+// here: blocks introduced by the optimizer (e.g., class checks of polymorphic
+// inlining) have no edge counts of their own.
+static bool IsColdBlock(BlockEntryInstr* block) {
+  if (block->IsCatchBlockEntry()) {
+    return true;
+  }
+  Instruction* last = block->last_instruction();
+  return last->IsThrow() || last->IsReThrow();
+}
+
+
 void BlockScheduler::ReorderBlocks() const {
   // Add every block to a chain of length 1 and compute a list of edges
   // sorted by weight.
@@ -200,12 +215,31 @@ void BlockScheduler::ReorderBlocks() const {
 
   // Build a new block order.  Emit each chain when its first block occurs
   // in the original reverse postorder ordering (which gives a topological
-  // sort of the blocks).
+  // sort of the blocks).  Chains starting with a cold block are collected
+  // and emitted after all hot chains so that the hot path of the function
+  // stays contiguous; they are followed by the out-of-line slow paths and
+  // deoptimization stubs emitted by the flow graph compiler.
+  GrowableArray<BlockEntryInstr*>* block_order =
+      flow_graph()->CodegenBlockOrder(true);
+  GrowableArray<Chain*> cold_chains;
   for (intptr_t i = block_count - 1; i >= 0; --i) {
-    if (chains[i]->first->block == flow_graph()->postorder()[i]) {
-      for (Link* link = chains[i]->first; link != NULL; link = link->next) {
-        flow_graph()->CodegenBlockOrder(true)->Add(link->block);
-      }
+    Chain* chain = chains[i];
+    if (chain->first->block != flow_graph()->postorder()[i]) {
+      continue;
+    }
+    if (FLAG_move_cold_blocks &&
+        (chain->first->block != flow_graph()->graph_entry()) &&
+        IsColdBlock(chain->first->block)) {
+      cold_chains.Add(chain);
+      continue;
+    }
+    for (Link* link = chain->first; link != NULL; link = link->next) {
+      block_order->Add(link->block);
+    }
+  }
+  for (intptr_t i = 0; i < cold_chains.length(); ++i) {
+    for (Link* link = cold_chains[i]->first; link != NULL; link = link->next) {
+      block_order->Add(link->block);
     }
   }
 }
@@ -0,0 +1,97 @@
+// Copyright (c) 2016, the Dart project authors.  Please see the AUTHORS file
+// for details. All rights reserved. Use of this source code is governed by a
+// BSD-style license that can be found in the LICENSE file.
+
+#include "platform/assert.h"
+#include "vm/compiler.h"
+#include "vm/globals.h"
+#include "vm/object.h"
+#include "vm/symbols.h"
+#include "vm/unit_test.h"
+
+namespace dart {
+
+DECLARE_FLAG(bool, move_cold_blocks);
+
+// Optimizes the top-level function 'name' of the test script and returns the
+// pc offsets of the two closure calls in it, in source order.
+static void GetClosureCallOffsets(const char* name,
+                                  uword* first_pc_offset,
+                                  uword* second_pc_offset) {
+  Thread* thread = Thread::Current();
+  const Library& lib = Library::Handle(Library::LookupLibrary(
+      String::Handle(String::New(TestCase::url()))));
+  EXPECT(!lib.IsNull());
+  const Function& function = Function::Handle(
+      lib.LookupLocalFunction(String::Handle(Symbols::New(name))));
+  EXPECT(!function.IsNull());
+  EXPECT(Error::Handle(
+      Compiler::CompileOptimizedFunction(thread, function)).IsNull());
+  EXPECT(function.HasOptimizedCode());
+
+  // Closure calls are the only calls in the functions below; each records a
+  // deoptimization descriptor after the call.
+  const Code& code = Code::Handle(function.CurrentCode());
+  const PcDescriptors& descriptors =
+      PcDescriptors::Handle(code.pc_descriptors());
+  PcDescriptors::Iterator iter(descriptors, RawPcDescriptors::kDeopt);
+  intptr_t count = 0;
+  intptr_t first_token_pos = 0;
+  while (iter.MoveNext()) {
+    if (count == 0) {
+      *first_pc_offset = iter.PcOffset();
+      first_token_pos = iter.TokenPos();
+    } else if (iter.TokenPos() < first_token_pos) {
+      *second_pc_offset = *first_pc_offset;
+      *first_pc_offset = iter.PcOffset();
+    } else {
+      *second_pc_offset = iter.PcOffset();
+    }
+    count++;
+  }
+  EXPECT_EQ(2, count);
+}
+
+
+TEST_CASE(BlockScheduler_MoveColdBlocks) {
+  const char* kScriptChars =
+      "throwCold(x, f) {\n"
+      "  if (x) {\n"
+      "    f();\n"
+      "    throw 'cold';\n"
+      "  }\n"
+      "  return f();\n"
+      "}\n"
+      "catchCold(f, g) {\n"
+      "  try {\n"
+      "    return f();\n"
+      "  } catch (e) {\n"
+      "    return g();\n"
+      "  }\n"
+      "}\n"
+      "main() {\n"
+      "  var f = () => 1;\n"
+      "  for (var i = 0; i < 20; i++) {\n"
+      "    throwCold(false, f);\n"
+      "    catchCold(f, f);\n"
+      "  }\n"
+      "}\n";
+  EXPECT(FLAG_move_cold_blocks);
+  Dart_Handle lib = TestCase::LoadTestScript(kScriptChars, NULL);
+  Dart_Handle result = Dart_Invoke(lib, NewString("main"), 0, NULL);
+  EXPECT_VALID(result);
+
+  uword cold_pc_offset = 0;
+  uword hot_pc_offset = 0;
+
+  // The block ending in a throw comes first in the source but is placed
+  // after the returning path.
+  GetClosureCallOffsets("throwCold", &cold_pc_offset, &hot_pc_offset);
+  EXPECT(hot_pc_offset < cold_pc_offset);
+
+  // The catch block is placed after the try body.
+  GetClosureCallOffsets("catchCold", &hot_pc_offset, &cold_pc_offset);
+  EXPECT(hot_pc_offset < cold_pc_offset);
+}
+
+}  // namespace dart
@@ -1619,7 +1619,10 @@ DEOPT_REASONS(DEOPT_REASON_TO_TEXT)
 }
 
 
-void DeoptimizeAt(const Code& optimized_code, uword pc) {
+// Switches the function of 'optimized_code' to its unoptimized code, compiling
+// the unoptimized code first if needed. This may allocate code and must
+// therefore happen before any WritableInstructionsBatchScope is entered.
+static void PrepareDeoptimizationAt(const Code& optimized_code, uword pc) {
   ASSERT(optimized_code.is_optimized());
   Thread* thread = Thread::Current();
   Zone* zone = thread->zone();
@@ -1641,17 +1644,19 @@ void DeoptimizeAt(const Code& optimized_code, uword pc) {
   if (function.HasOptimizedCode()) {
     function.SwitchToUnoptimizedCode();
   }
+}
+
+
+// Patches the call site at 'pc' to jump to the lazy deoptimization code of
+// 'optimized_code'. The instructions must already be writable.
+static void PatchDeoptimizationAt(const Code& optimized_code, uword pc) {
   // Patch call site (lazy deoptimization is quite rare, patching it twice
   // is not a performance issue).
   uword lazy_deopt_jump = optimized_code.GetLazyDeoptPc();
   ASSERT(lazy_deopt_jump != 0);
-  const Instructions& instrs =
-      Instructions::Handle(zone, optimized_code.instructions());
-  {
-    WritableInstructionsScope writable(instrs.EntryPoint(), instrs.size());
-    CodePatcher::InsertDeoptimizationCallAt(pc, lazy_deopt_jump);
-  }
+  CodePatcher::InsertDeoptimizationCallAt(pc, lazy_deopt_jump);
   if (FLAG_trace_patching) {
+    const Function& function = Function::Handle(optimized_code.function());
     const String& name = String::Handle(function.name());
     OS::PrintErr("InsertDeoptimizationCallAt: %" Px " to %" Px " for %s\n", pc,
                  lazy_deopt_jump, name.ToCString());
@@ -1661,19 +1666,53 @@ void DeoptimizeAt(const Code& optimized_code, uword pc) {
 }
 
 
+void DeoptimizeAt(const Code& optimized_code, uword pc) {
+  PrepareDeoptimizationAt(optimized_code, pc);
+  const Instructions& instrs =
+      Instructions::Handle(optimized_code.instructions());
+  WritableInstructionsScope writable(instrs.EntryPoint(), instrs.size());
+  PatchDeoptimizationAt(optimized_code, pc);
+}
+
+
+void DeoptimizeAt(const GrowableArray<const Code*>& optimized_codes,
+                  const GrowableArray<uword>& pcs) {
+  ASSERT(optimized_codes.length() == pcs.length());
+  for (intptr_t i = 0; i < optimized_codes.length(); i++) {
+    PrepareDeoptimizationAt(*optimized_codes[i], pcs[i]);
+  }
+  // All unoptimized code now exists, so every call site can be patched
+  // with each affected code page made writable only once.
+  WritableInstructionsBatchScope writable;
+  Instructions& instrs = Instructions::Handle();
+  for (intptr_t i = 0; i < optimized_codes.length(); i++) {
+    instrs = optimized_codes[i]->instructions();
+    writable.MakeWritable(instrs.EntryPoint(), instrs.size());
+  }
+  for (intptr_t i = 0; i < optimized_codes.length(); i++) {
+    PatchDeoptimizationAt(*optimized_codes[i], pcs[i]);
+  }
+}
+
+
 // Currently checks only that all optimized frames have kDeoptIndex
 // and unoptimized code has the kDeoptAfter.
 void DeoptimizeFunctionsOnStack() {
+  Zone* zone = Thread::Current()->zone();
+  GrowableArray<const Code*> optimized_codes;
+  GrowableArray<uword> pcs;
   DartFrameIterator iterator;
   StackFrame* frame = iterator.NextFrame();
-  Code& optimized_code = Code::Handle();
+  Code& code = Code::Handle(zone);
   while (frame != NULL) {
-    optimized_code = frame->LookupDartCode();
-    if (optimized_code.is_optimized()) {
-      DeoptimizeAt(optimized_code, frame->pc());
+    code = frame->LookupDartCode();
+    if (code.is_optimized()) {
+      optimized_codes.Add(&Code::ZoneHandle(zone, code.raw()));
+      pcs.Add(frame->pc());
     }
     frame = iterator.NextFrame();
   }
+  DeoptimizeAt(optimized_codes, pcs);
 }
 
 
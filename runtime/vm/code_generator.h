@@ -18,6 +18,10 @@ class Instance;
 const char* DeoptReasonToCString(ICData::DeoptReasonId deopt_reason);
 
 void DeoptimizeAt(const Code& optimized_code, uword pc);
+// Deoptimizes each optimized code object at the corresponding pc, patching
+// all of the call sites in one batch.
+void DeoptimizeAt(const GrowableArray<const Code*>& optimized_codes,
+                  const GrowableArray<uword>& pcs);
 void DeoptimizeFunctionsOnStack();
 
 double DartModulo(double a, double b);
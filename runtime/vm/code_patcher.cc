@@ -34,4 +34,65 @@ WritableInstructionsScope::~WritableInstructionsScope() {
   }
 }
 
+
+void WritableInstructionsBatchScope::MakeWritable(uword address,
+                                                  intptr_t size) {
+  if (!FLAG_write_protect_code) {
+    return;
+  }
+  const intptr_t page_size = VirtualMemory::PageSize();
+  const uword first_page = Utils::RoundDown(address, page_size);
+  const uword last_page = Utils::RoundDown(address + size - 1, page_size);
+  for (uword page = first_page; page <= last_page; page += page_size) {
+    bool already_writable = false;
+    for (intptr_t i = 0; i < pages_.length(); i++) {
+      if (pages_[i] == page) {
+        already_writable = true;
+        break;
+      }
+    }
+    if (!already_writable) {
+      bool status = VirtualMemory::Protect(reinterpret_cast<void*>(page),
+                                           page_size,
+                                           VirtualMemory::kReadWrite);
+      ASSERT(status);
+      pages_.Add(page);
+    }
+  }
+}
+
+
+static int CompareAddresses(const uword* a, const uword* b) {
+  if (*a < *b) {
+    return -1;
+  } else if (*a > *b) {
+    return 1;
+  }
+  return 0;
+}
+
+
+WritableInstructionsBatchScope::~WritableInstructionsBatchScope() {
+  if (!FLAG_write_protect_code || pages_.is_empty()) {
+    return;
+  }
+  // Reset the protection of runs of adjacent pages with a single call.
+  const intptr_t page_size = VirtualMemory::PageSize();
+  pages_.Sort(CompareAddresses);
+  intptr_t i = 0;
+  while (i < pages_.length()) {
+    const uword start = pages_[i];
+    uword end = start + page_size;
+    i++;
+    while ((i < pages_.length()) && (pages_[i] == end)) {
+      end += page_size;
+      i++;
+    }
+    bool status = VirtualMemory::Protect(reinterpret_cast<void*>(start),
+                                         end - start,
+                                         VirtualMemory::kReadExecute);
+    ASSERT(status);
+  }
+}
+
 }  // namespace dart
@@ -7,6 +7,7 @@
 #define VM_CODE_PATCHER_H_
 
 #include "vm/allocation.h"
+#include "vm/growable_array.h"
 #include "vm/native_entry.h"
 
 namespace dart {
@@ -40,6 +41,26 @@ class WritableInstructionsScope : public ValueObject {
 };
 
 
+// Stack-allocated class to create a scope in which several regions of
+// generated code are patched together. Each page covered by a region added
+// with MakeWritable is given write access only once, and all of them are
+// reset to read-execute in the destructor of this scope. Code must not be
+// allocated while this scope is active, since finalizing new instructions
+// resets the protection of the pages they live on.
+class WritableInstructionsBatchScope : public ValueObject {
+ public:
+  WritableInstructionsBatchScope() : pages_() { }
+  ~WritableInstructionsBatchScope();
+
+  void MakeWritable(uword address, intptr_t size);
+
+ private:
+  GrowableArray<uword> pages_;
+
+  DISALLOW_COPY_AND_ASSIGN(WritableInstructionsBatchScope);
+};
+
+
 class CodePatcher : public AllStatic {
  public:
   // Dart static calls have a distinct, machine-dependent code pattern.
@@ -24,7 +24,9 @@
 #include "vm/flow_graph_inliner.h"
 #include "vm/flow_graph_optimizer.h"
 #include "vm/flow_graph_type_propagator.h"
+#include "vm/hash_table.h"
 #include "vm/il_printer.h"
+#include "vm/json_stream.h"
 #include "vm/longjump.h"
 #include "vm/object.h"
 #include "vm/object_store.h"
@@ -44,6 +46,8 @@ DEFINE_FLAG(bool, allocation_sinking, true,
     "Attempt to sink temporary allocations to side exits");
 DEFINE_FLAG(bool, common_subexpression_elimination, true,
     "Do common subexpression elimination.");
+DEFINE_FLAG(bool, compiler_profile, false,
+    "Record per-function compilation statistics for the compiler profile.");
 DEFINE_FLAG(bool, constant_propagation, true,
     "Do conditional constant propagation/unreachable code elimination.");
 DEFINE_FLAG(int, max_deoptimization_counter_threshold, 16,
@@ -595,6 +599,21 @@ void CompileParsedFunctionHelper::FinalizeCompilation(
 }
 
 
+static intptr_t CountInstructions(FlowGraph* flow_graph) {
+  intptr_t count = 0;
+  for (BlockIterator block_it = flow_graph->reverse_postorder_iterator();
+       !block_it.Done();
+       block_it.Advance()) {
+    for (ForwardInstructionIterator it(block_it.Current());
+         !it.Done();
+         it.Advance()) {
+      count++;
+    }
+  }
+  return count;
+}
+
+
 // Return false if bailed out.
 // If optimized_result_code is not NULL then it is caller's responsibility
 // to install code.
@@ -624,6 +643,8 @@ bool CompileParsedFunctionHelper::Compile(CompilationPipeline* pipeline) {
 
   while (!done) {
     const intptr_t prev_deopt_id = thread()->deopt_id();
+    const int64_t compile_start_micros =
+        FLAG_compiler_profile ? OS::GetCurrentMonotonicMicros() : 0;
     thread()->set_deopt_id(0);
     LongJumpScope jump;
     const intptr_t val = setjmp(*jump.Set());
@@ -1031,6 +1052,10 @@ bool CompileParsedFunctionHelper::Compile(CompilationPipeline* pipeline) {
       }
 
       ASSERT(inline_id_to_function.length() == caller_inline_id.length());
+      const intptr_t il_instruction_count =
+          FLAG_compiler_profile ? CountInstructions(flow_graph) : 0;
+      const intptr_t inlined_function_count =
+          Utils::Maximum<intptr_t>(0, inline_id_to_function.length() - 1);
       Assembler assembler(use_far_branches);
       FlowGraphCompiler graph_compiler(&assembler, flow_graph,
                                        *parsed_function(), optimized(),
@@ -1050,6 +1075,12 @@ bool CompileParsedFunctionHelper::Compile(CompilationPipeline* pipeline) {
                                   "FinalizeCompilation");
         if (thread()->IsMutatorThread()) {
           FinalizeCompilation(&assembler, &graph_compiler, flow_graph);
+          if (FLAG_compiler_profile) {
+            CompilerProfile::RecordCompilation(
+                isolate(), function,
+                OS::GetCurrentMonotonicMicros() - compile_start_micros,
+                il_instruction_count, inlined_function_count);
+          }
         } else {
           // This part of compilation must be at a safepoint.
           // Stop mutator thread before creating the instruction object and
@@ -1064,6 +1095,12 @@ bool CompileParsedFunctionHelper::Compile(CompilationPipeline* pipeline) {
             // heap to grow.
             NoHeapGrowthControlScope no_growth_control;
             FinalizeCompilation(&assembler, &graph_compiler, flow_graph);
+            if (FLAG_compiler_profile) {
+              CompilerProfile::RecordCompilation(
+                  isolate(), function,
+                  OS::GetCurrentMonotonicMicros() - compile_start_micros,
+                  il_instruction_count, inlined_function_count);
+            }
           }
           isolate()->thread_registry()->ResumeAllThreads();
           if (isolate()->heap()->NeedsGarbageCollection()) {
@@ -2048,4 +2085,129 @@ void BackgroundCompiler::EnsureInit(Thread* thread) {
 
 #endif  // DART_PRECOMPILED_RUNTIME
 
+
+// Traits for looking up compiler profile entries by function.
+class CompilerProfileTraits {
+ public:
+  static bool IsMatch(const Object& a, const Object& b) {
+    return a.raw() == b.raw();
+  }
+  static uword Hash(const Object& key) {
+    return String::HashRawSymbol(Function::Cast(key).name());
+  }
+};
+typedef UnorderedHashMap<CompilerProfileTraits> CompilerProfileMap;
+
+
+static void AddToEntry(const Array& entry, intptr_t index, int64_t value) {
+  const int64_t sum = Smi::Value(Smi::RawCast(entry.At(index))) + value;
+  entry.SetAt(index, Smi::Handle(Smi::New(
+      static_cast<intptr_t>(Utils::Minimum<int64_t>(sum, Smi::kMaxValue)))));
+}
+
+
+void CompilerProfile::RecordCompilation(Isolate* isolate,
+                                        const Function& function,
+                                        int64_t compile_micros,
+                                        intptr_t il_instruction_count,
+                                        intptr_t inlined_function_count) {
+  Zone* zone = Thread::Current()->zone();
+  Array& profile = Array::Handle(zone, isolate->compiler_profile());
+  if (profile.IsNull()) {
+    const intptr_t kInitialCapacity = 64;
+    profile = HashTables::New<CompilerProfileMap>(kInitialCapacity,
+                                                  Heap::kOld);
+  }
+  CompilerProfileMap map(zone, profile.raw());
+  Array& entry = Array::Handle(zone);
+  entry ^= map.GetOrNull(function);
+  if (entry.IsNull()) {
+    entry = Array::New(kEntryLength, Heap::kOld);
+    for (intptr_t i = 0; i < kEntryLength; i++) {
+      entry.SetAt(i, Smi::Handle(zone, Smi::New(0)));
+    }
+    map.UpdateOrInsert(function, entry);
+  }
+  AddToEntry(entry, kCompilationsIndex, 1);
+  AddToEntry(entry, kCompileMicrosIndex, compile_micros);
+  // The sizes describe the most recent compilation.
+  entry.SetAt(kILInstructionCountIndex,
+              Smi::Handle(zone, Smi::New(il_instruction_count)));
+  entry.SetAt(kInlinedFunctionCountIndex,
+              Smi::Handle(zone, Smi::New(inlined_function_count)));
+  profile = map.Release().raw();
+  isolate->set_compiler_profile(profile);
+}
+
+
+struct CompilerProfileEntry {
+  const Function* function;
+  const Array* entry;
+  intptr_t compile_micros;
+};
+
+
+static int CompareCompileMicros(const CompilerProfileEntry* a,
+                                const CompilerProfileEntry* b) {
+  // Sort in decreasing order of compile time.
+  if (a->compile_micros > b->compile_micros) {
+    return -1;
+  } else if (a->compile_micros < b->compile_micros) {
+    return 1;
+  }
+  return 0;
+}
+
+
+void CompilerProfile::PrintJSON(Isolate* isolate,
+                                JSONStream* stream,
+                                intptr_t limit) {
+  Zone* zone = Thread::Current()->zone();
+  GrowableArray<CompilerProfileEntry> entries;
+  const Array& profile = Array::Handle(zone, isolate->compiler_profile());
+  if (!profile.IsNull()) {
+    CompilerProfileMap map(zone, profile.raw());
+    CompilerProfileMap::Iterator it(&map);
+    while (it.MoveNext()) {
+      const intptr_t index = it.Current();
+      CompilerProfileEntry entry;
+      entry.function = &Function::ZoneHandle(zone,
+          Function::RawCast(map.GetKey(index)));
+      entry.entry = &Array::ZoneHandle(zone,
+          Array::RawCast(map.GetPayload(index, 0)));
+      entry.compile_micros =
+          Smi::Value(Smi::RawCast(entry.entry->At(kCompileMicrosIndex)));
+      entries.Add(entry);
+    }
+    map.Release();
+  }
+  entries.Sort(CompareCompileMicros);
+  const intptr_t num_entries = ((limit < 0) || (limit > entries.length())) ?
+      entries.length() : limit;
+
+  JSONObject jsobj(stream);
+  jsobj.AddProperty("type", "_CompilerProfile");
+  jsobj.AddProperty("enabled", FLAG_compiler_profile);
+  jsobj.AddProperty("totalFunctions", entries.length());
+  JSONArray members(&jsobj, "members");
+  for (intptr_t i = 0; i < num_entries; i++) {
+    const Function& function = *entries[i].function;
+    const Array& entry = *entries[i].entry;
+    JSONObject member(&members);
+    member.AddProperty("type", "_CompilerProfileEntry");
+    member.AddProperty("function", function);
+    member.AddProperty("compilations",
+        Smi::Value(Smi::RawCast(entry.At(kCompilationsIndex))));
+    member.AddProperty("compileTime",
+        Smi::Value(Smi::RawCast(entry.At(kCompileMicrosIndex))));
+    member.AddProperty("ilInstructionCount",
+        Smi::Value(Smi::RawCast(entry.At(kILInstructionCountIndex))));
+    member.AddProperty("inlinedFunctionCount",
+        Smi::Value(Smi::RawCast(entry.At(kInlinedFunctionCountIndex))));
+    member.AddProperty("deoptimizations",
+        static_cast<intptr_t>(function.deoptimization_counter()));
+    member.AddProperty("optimized", function.HasOptimizedCode());
+  }
+}
+
 }  // namespace dart
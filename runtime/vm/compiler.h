@@ -18,6 +18,8 @@ class Class;
 class Code;
 class CompilationWorkQueue;
 class Function;
+class Isolate;
+class JSONStream;
 class Library;
 class ParsedFunction;
 class QueueElement;
@@ -112,6 +114,33 @@ class Compiler : public AllStatic {
 };
 
 
+// Per-function compilation statistics of an isolate, collected when
+// --compiler_profile is set and reported by the _getCompilerProfile
+// service RPC.
+class CompilerProfile : public AllStatic {
+ public:
+  enum {
+    kCompilationsIndex = 0,
+    kCompileMicrosIndex,
+    kILInstructionCountIndex,
+    kInlinedFunctionCountIndex,
+    kEntryLength,
+  };
+
+  // Accounts one successful compilation of 'function'. Must be called on the
+  // mutator thread or at a safepoint.
+  static void RecordCompilation(Isolate* isolate,
+                                const Function& function,
+                                int64_t compile_micros,
+                                intptr_t il_instruction_count,
+                                intptr_t inlined_function_count);
+
+  // Prints at most 'limit' functions, ordered by decreasing total compile
+  // time. A negative 'limit' prints all recorded functions.
+  static void PrintJSON(Isolate* isolate, JSONStream* stream, intptr_t limit);
+};
+
+
 // Class to run optimizing compilation in a background thread.
 // Current implementation: one task per isolate, it dies with the owning
 // isolate.
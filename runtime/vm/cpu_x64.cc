@@ -18,6 +18,7 @@
 namespace dart {
 
 DEFINE_FLAG(bool, use_sse41, true, "Use SSE 4.1 if available");
+DEFINE_FLAG(bool, use_lzcnt, true, "Use LZCNT if available");
 
 
 void CPU::FlushICache(uword start, uword size) {
@@ -32,6 +33,7 @@ const char* CPU::Id() {
 
 bool HostCPUFeatures::sse2_supported_ = true;
 bool HostCPUFeatures::sse4_1_supported_ = false;
+bool HostCPUFeatures::lzcnt_supported_ = false;
 const char* HostCPUFeatures::hardware_ = NULL;
 #if defined(DEBUG)
 bool HostCPUFeatures::initialized_ = false;
@@ -43,6 +45,10 @@ void HostCPUFeatures::InitOnce() {
   sse4_1_supported_ =
       CpuInfo::FieldContains(kCpuInfoFeatures, "sse4_1") ||
       CpuInfo::FieldContains(kCpuInfoFeatures, "sse4.1");
+  // Linux reports LZCNT as part of "abm" in /proc/cpuinfo.
+  lzcnt_supported_ =
+      CpuInfo::FieldContains(kCpuInfoFeatures, "lzcnt") ||
+      CpuInfo::FieldContains(kCpuInfoFeatures, "abm");
 
 #if defined(DEBUG)
   initialized_ = true;
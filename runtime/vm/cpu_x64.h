@@ -11,6 +11,7 @@
 namespace dart {
 
 DECLARE_FLAG(bool, use_sse41);
+DECLARE_FLAG(bool, use_lzcnt);
 
 class HostCPUFeatures : public AllStatic {
  public:
@@ -28,6 +29,10 @@ class HostCPUFeatures : public AllStatic {
     DEBUG_ASSERT(initialized_);
     return sse4_1_supported_ && FLAG_use_sse41;
   }
+  static bool lzcnt_supported() {
+    DEBUG_ASSERT(initialized_);
+    return lzcnt_supported_ && FLAG_use_lzcnt;
+  }
 
  private:
   static const uint64_t kSSE2BitMask = static_cast<uint64_t>(1) << 26;
@@ -35,6 +40,7 @@ class HostCPUFeatures : public AllStatic {
   static const char* hardware_;
   static bool sse2_supported_;
   static bool sse4_1_supported_;
+  static bool lzcnt_supported_;
 #if defined(DEBUG)
   static bool initialized_;
 #endif
@@ -57,6 +63,9 @@ class TargetCPUFeatures : public AllStatic {
   static bool sse4_1_supported() {
     return HostCPUFeatures::sse4_1_supported();
   }
+  static bool lzcnt_supported() {
+    return HostCPUFeatures::lzcnt_supported();
+  }
   static bool double_truncate_round_supported() {
     return false;
   }
@@ -19,6 +19,7 @@ namespace dart {
 
 bool CpuId::sse2_ = false;
 bool CpuId::sse41_ = false;
+bool CpuId::lzcnt_ = false;
 const char* CpuId::id_string_ = NULL;
 const char* CpuId::brand_string_ = NULL;
 
@@ -50,6 +51,13 @@ void CpuId::InitOnce() {
   CpuId::sse41_ = (info[2] & (1 << 19)) != 0;
   CpuId::sse2_ = (info[3] & (1 << 26)) != 0;
 
+  // LZCNT is reported in the extended feature flags (ABM on AMD).
+  GetCpuId(0x80000000, info);
+  if (info[0] >= 0x80000001) {
+    GetCpuId(0x80000001, info);
+    CpuId::lzcnt_ = (info[2] & (1 << 5)) != 0;
+  }
+
   char* brand_string =
       reinterpret_cast<char*>(malloc(3 * 4 * sizeof(uint32_t)));
   for (uint32_t i = 0x80000002; i <= 0x80000004; i++) {
@@ -94,15 +102,23 @@ const char* CpuId::field(CpuInfoIndices idx) {
     case kCpuInfoHardware:
       return brand_string();
     case kCpuInfoFeatures: {
-      if (sse2() && sse41()) {
-        return strdup("sse2 sse4.1");
-      } else if (sse2()) {
-        return strdup("sse2");
-      } else if (sse41()) {
-        return strdup("sse4.1");
-      } else {
-        return strdup("");
+      char buffer[64];
+      buffer[0] = '\0';
+      if (sse2()) {
+        strncat(buffer, "sse2 ", sizeof(buffer) - strlen(buffer) - 1);
+      }
+      if (sse41()) {
+        strncat(buffer, "sse4.1 ", sizeof(buffer) - strlen(buffer) - 1);
+      }
+      if (lzcnt()) {
+        strncat(buffer, "lzcnt ", sizeof(buffer) - strlen(buffer) - 1);
+      }
+      // Drop the trailing space.
+      const intptr_t length = strlen(buffer);
+      if (length > 0) {
+        buffer[length - 1] = '\0';
       }
+      return strdup(buffer);
     }
     default: {
       UNREACHABLE();
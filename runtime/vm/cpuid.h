@@ -28,6 +28,7 @@ class CpuId : public AllStatic {
 
   static bool sse2() { return sse2_; }
   static bool sse41() { return sse41_; }
+  static bool lzcnt() { return lzcnt_; }
 
   // Caller must free the result of id_string and brand_string.
   static const char* id_string();
@@ -36,6 +37,7 @@ class CpuId : public AllStatic {
  private:
   static bool sse2_;
   static bool sse41_;
+  static bool lzcnt_;
   static const char* id_string_;
   static const char* brand_string_;
 
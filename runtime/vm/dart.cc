@@ -373,6 +373,12 @@ RawError* Dart::InitializeIsolate(const uint8_t* snapshot_buffer, void* data) {
   const Code& miss_code =
       Code::Handle(I->object_store()->megamorphic_miss_code());
   I->set_ic_miss_code(miss_code);
+  // The dispatch table is built by the precompiler and comes from the snapshot.
+  Array& dispatch_table = Array::Handle(I->object_store()->dispatch_table());
+  if (dispatch_table.IsNull()) {
+    dispatch_table = Object::empty_array().raw();
+  }
+  I->set_dispatch_table(dispatch_table);
 
   if (snapshot_buffer == NULL) {
     if (!I->object_store()->PreallocateObjects()) {
@@ -35,26 +35,33 @@ class StacktraceBuilder : public ValueObject {
 };
 
 
+// Collects the frames of a stack trace directly into arrays sized for the
+// number of Dart frames on the stack, so that capturing a trace does not
+// repeatedly grow and then copy intermediate lists. Only the code object and
+// pc offset of each frame are recorded here; functions, scripts and line
+// numbers are resolved when the trace is actually printed or inspected.
 class RegularStacktraceBuilder : public StacktraceBuilder {
  public:
-  explicit RegularStacktraceBuilder(Zone* zone)
-      : code_list_(
-          GrowableObjectArray::Handle(zone, GrowableObjectArray::New())),
-        pc_offset_list_(
-          GrowableObjectArray::Handle(zone, GrowableObjectArray::New())) { }
+  RegularStacktraceBuilder(Zone* zone, intptr_t num_frames)
+      : code_array_(Array::Handle(zone, Array::New(num_frames))),
+        pc_offset_array_(Array::Handle(zone, Array::New(num_frames))),
+        cur_index_(0) { }
   ~RegularStacktraceBuilder() { }
 
-  const GrowableObjectArray& code_list() const { return code_list_; }
-  const GrowableObjectArray& pc_offset_list() const { return pc_offset_list_; }
+  const Array& code_array() const { return code_array_; }
+  const Array& pc_offset_array() const { return pc_offset_array_; }
 
   virtual void AddFrame(const Code& code, const Smi& offset) {
-    code_list_.Add(code);
-    pc_offset_list_.Add(offset);
+    ASSERT(cur_index_ < code_array_.Length());
+    code_array_.SetAt(cur_index_, code);
+    pc_offset_array_.SetAt(cur_index_, offset);
+    cur_index_ += 1;
   }
 
  private:
-  const GrowableObjectArray& code_list_;
-  const GrowableObjectArray& pc_offset_list_;
+  const Array& code_array_;
+  const Array& pc_offset_array_;
+  intptr_t cur_index_;
 
   DISALLOW_COPY_AND_ASSIGN(RegularStacktraceBuilder);
 };
@@ -111,6 +118,21 @@ void PreallocatedStacktraceBuilder::AddFrame(const Code& code,
 }
 
 
+static intptr_t CountDartFrames() {
+  StackFrameIterator frames(StackFrameIterator::kDontValidateFrames);
+  StackFrame* frame = frames.NextFrame();
+  ASSERT(frame != NULL);  // We expect to find a dart invocation frame.
+  intptr_t num_frames = 0;
+  while (frame != NULL) {
+    if (frame->IsDartFrame()) {
+      num_frames++;
+    }
+    frame = frames.NextFrame();
+  }
+  return num_frames;
+}
+
+
 static void BuildStackTrace(StacktraceBuilder* builder) {
   StackFrameIterator frames(StackFrameIterator::kDontValidateFrames);
   StackFrame* frame = frames.NextFrame();
@@ -276,16 +298,12 @@ static RawField* LookupStacktraceField(const Instance& instance) {
 
 RawStacktrace* Exceptions::CurrentStacktrace() {
   Zone* zone = Thread::Current()->zone();
-  RegularStacktraceBuilder frame_builder(zone);
+  RegularStacktraceBuilder frame_builder(zone, CountDartFrames());
   BuildStackTrace(&frame_builder);
 
-  // Create arrays for code and pc_offset tuples of each frame.
-  const Array& full_code_array = Array::Handle(zone,
-      Array::MakeArray(frame_builder.code_list()));
-  const Array& full_pc_offset_array = Array::Handle(zone,
-      Array::MakeArray(frame_builder.pc_offset_list()));
   const Stacktrace& full_stacktrace = Stacktrace::Handle(
-      Stacktrace::New(full_code_array, full_pc_offset_array));
+      Stacktrace::New(frame_builder.code_array(),
+                      frame_builder.pc_offset_array()));
   return full_stacktrace.raw();
 }
 
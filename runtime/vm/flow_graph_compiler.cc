@@ -19,6 +19,7 @@
 #include "vm/locations.h"
 #include "vm/log.h"
 #include "vm/longjump.h"
+#include "vm/megamorphic_cache_table.h"
 #include "vm/object_store.h"
 #include "vm/parser.h"
 #include "vm/raw_object.h"
@@ -70,6 +71,7 @@ DECLARE_FLAG(charp, stacktrace_filter);
 DECLARE_FLAG(bool, support_debugger);
 DECLARE_FLAG(bool, use_field_guards);
 DECLARE_FLAG(bool, use_cha_deopt);
+DECLARE_FLAG(bool, use_dispatch_table);
 DECLARE_FLAG(bool, use_osr);
 DECLARE_FLAG(bool, warn_on_javascript_compatibility);
 DECLARE_FLAG(bool, print_stop_message);
@@ -1146,6 +1148,15 @@ void FlowGraphCompiler::GenerateInstanceCall(
     const ICData& ic_data_in) {
   const ICData& ic_data = ICData::ZoneHandle(ic_data_in.Original());
   if (Compiler::always_optimize()) {
+    if (FLAG_use_dispatch_table) {
+      // Register the selector so that it gets a row in the dispatch table in
+      // case the call site becomes megamorphic at run time. This creates one
+      // cache per selector; BuildDispatchTable drops the ones that get no row.
+      const String& name = String::Handle(zone(), ic_data.target_name());
+      const Array& arguments_descriptor =
+          Array::Handle(zone(), ic_data.arguments_descriptor());
+      MegamorphicCacheTable::Lookup(isolate(), name, arguments_descriptor);
+    }
     EmitSwitchableInstanceCall(ic_data, argument_count,
                                deopt_id, token_pos, locs);
     return;
@@ -55,6 +55,9 @@ DEFINE_FLAG(int, inlining_recursion_depth_threshold, 1,
 DEFINE_FLAG(int, max_inlined_per_depth, 500,
     "Max. number of inlined calls per depth");
 DEFINE_FLAG(bool, print_inlining_tree, false, "Print inlining tree");
+DEFINE_FLAG(bool, specialize_closure_arguments, true,
+    "Treat closure literals passed as arguments like constants when deciding "
+    "to inline, and call known closure targets directly.");
 DEFINE_FLAG(bool, enable_inlining_annotations, false,
             "Enable inlining annotations");
 
@@ -102,6 +105,24 @@ static ConstantInstr* GetDefaultValue(intptr_t i,
 }
 
 
+// Returns the function of the closure 'closure' evaluates to if it is known at
+// compile time, i.e. the closure is allocated in this graph or is a constant.
+// Returns null otherwise.
+static RawFunction* KnownClosureFunction(Definition* closure) {
+  Definition* defn = closure->OriginalDefinition();
+  AllocateObjectInstr* alloc = defn->AsAllocateObject();
+  if ((alloc != NULL) && !alloc->closure_function().IsNull()) {
+    ASSERT(alloc->cls().IsClosureClass());
+    return alloc->closure_function().raw();
+  }
+  ConstantInstr* constant = defn->AsConstant();
+  if ((constant != NULL) && constant->value().IsClosure()) {
+    return Closure::Cast(constant->value()).function();
+  }
+  return Function::null();
+}
+
+
 // Pair of an argument name and its value.
 struct NamedArgument {
   String* name;
@@ -319,7 +340,11 @@ class CallSites : public ValueObject {
           target = static_call->function().raw();
           call = static_call;
         } else if (current->IsClosureCall()) {
-          // TODO(srdjan): Add data for closure calls.
+          ClosureCallInstr* closure_call = current->AsClosureCall();
+          target = KnownClosureFunction(closure_call->ArgumentAt(0));
+          if (!target.IsNull()) {
+            call = closure_call;
+          }
         }
         if (call != NULL) {
           inlined_info->Add(InlinedInfo(
@@ -500,6 +525,8 @@ class CallSiteInliner : public ValueObject {
         inlined_recursive_call_(false),
         inlining_depth_(1),
         inlining_recursion_depth_(0),
+        inlined_closure_calls_(0),
+        devirtualized_closure_calls_(0),
         collected_call_sites_(NULL),
         inlining_call_sites_(NULL),
         function_cache_(),
@@ -656,17 +683,24 @@ class CallSiteInliner : public ValueObject {
 
     GrowableArray<Value*>* arguments = call_data->arguments;
     const intptr_t constant_arguments = CountConstants(*arguments);
+    // A closure literal passed to a higher-order callee (e.g. forEach)
+    // specializes the inlined body just like a constant does: the closure
+    // call inside the callee becomes a direct call that can be inlined in
+    // turn.
+    const intptr_t closure_arguments = CountKnownClosures(*arguments);
     if (!ShouldWeInline(function,
                         function.optimized_instruction_count(),
                         function.optimized_call_site_count(),
-                        constant_arguments)) {
+                        constant_arguments + closure_arguments)) {
       TRACE_INLINING(THR_Print("     Bailout: early heuristics with "
                                "code size:  %" Pd ", "
                                "call sites: %" Pd ", "
-                               "const args: %" Pd "\n",
+                               "const args: %" Pd ", "
+                               "closure args: %" Pd "\n",
                                function.optimized_instruction_count(),
                                function.optimized_call_site_count(),
-                               constant_arguments));
+                               constant_arguments,
+                               closure_arguments));
       PRINT_INLINING_TREE("Early heuristic",
           &call_data->caller, &function, call_data->call);
       return false;
@@ -814,7 +848,7 @@ class CallSiteInliner : public ValueObject {
 
         // Collect information about the call site and caller graph.
         // TODO(zerny): Do this after CP and dead code elimination.
-        intptr_t constants_count = 0;
+        intptr_t constants_count = closure_arguments;
         for (intptr_t i = 0; i < param_stubs->length(); ++i) {
           if ((*param_stubs)[i]->IsConstant()) ++constants_count;
         }
@@ -839,10 +873,12 @@ class CallSiteInliner : public ValueObject {
           TRACE_INLINING(THR_Print("     Bailout: heuristics with "
                                    "code size:  %" Pd ", "
                                    "call sites: %" Pd ", "
-                                   "const args: %" Pd "\n",
+                                   "const args: %" Pd ", "
+                                   "closure args: %" Pd "\n",
                                    size,
                                    call_site_count,
-                                   constants_count));
+                                   constants_count - closure_arguments,
+                                   closure_arguments));
           PRINT_INLINING_TREE("Heuristic fail",
               &call_data->caller, &function, call_data->call);
           return false;
@@ -926,6 +962,11 @@ class CallSiteInliner : public ValueObject {
           GrowthFactor(),
           initial_size_,
           inlined_size_);
+      if ((inlined_closure_calls_ > 0) || (devirtualized_closure_calls_ > 0)) {
+        THR_Print("Closure calls: inlined %" Pd ", devirtualized %" Pd "\n",
+            inlined_closure_calls_,
+            devirtualized_closure_calls_);
+      }
       PrintInlinedInfoFor(top, 1);
     }
   }
@@ -1050,6 +1091,21 @@ class CallSiteInliner : public ValueObject {
     return count;
   }
 
+  // Counts the arguments that are closures with a statically known function.
+  // Constant closures are already counted by CountConstants.
+  static intptr_t CountKnownClosures(const GrowableArray<Value*>& arguments) {
+    if (!FLAG_specialize_closure_arguments) return 0;
+    intptr_t count = 0;
+    for (intptr_t i = 0; i < arguments.length(); i++) {
+      if (!arguments[i]->BindsToConstant() &&
+          (KnownClosureFunction(arguments[i]->definition()) !=
+               Function::null())) {
+        count++;
+      }
+    }
+    return count;
+  }
+
   // Parse a function reusing the cache if possible.
   ParsedFunction* GetParsedFunction(const Function& function, bool* in_cache) {
     // TODO(zerny): Use a hash map for the cache.
@@ -1123,20 +1179,8 @@ class CallSiteInliner : public ValueObject {
       ClosureCallInstr* call = call_info[call_idx].call;
       // Find the closure of the callee.
       ASSERT(call->ArgumentCount() > 0);
-      Function& target = Function::ZoneHandle();
-      AllocateObjectInstr* alloc =
-          call->ArgumentAt(0)->OriginalDefinition()->AsAllocateObject();
-      if ((alloc != NULL) && !alloc->closure_function().IsNull()) {
-        target ^= alloc->closure_function().raw();
-        ASSERT(alloc->cls().IsClosureClass());
-      }
-      ConstantInstr* constant =
-          call->ArgumentAt(0)->OriginalDefinition()->AsConstant();
-      if ((constant != NULL) &&
-          constant->value().IsClosure()) {
-        target ^= Closure::Cast(constant->value()).function();
-      }
-
+      const Function& target = Function::ZoneHandle(
+          KnownClosureFunction(call->ArgumentAt(0)));
       if (target.IsNull()) {
         TRACE_INLINING(THR_Print("     Bailout: non-closure operator\n"));
         continue;
@@ -1152,10 +1196,38 @@ class CallSiteInliner : public ValueObject {
                       call->argument_names(),
                       &call_data)) {
         InlineCall(&call_data);
+        ++inlined_closure_calls_;
+      } else if (FLAG_specialize_closure_arguments) {
+        DevirtualizeClosureCall(call, target);
       }
     }
   }
 
+  // Replaces a closure call whose target is known with a direct static call
+  // of the closure function. The closure stays the first argument, so the
+  // callee still loads its context from it.
+  void DevirtualizeClosureCall(ClosureCallInstr* call,
+                               const Function& target) {
+    ZoneGrowableArray<PushArgumentInstr*>* arguments =
+        new(Z) ZoneGrowableArray<PushArgumentInstr*>(call->ArgumentCount());
+    for (intptr_t i = 0; i < call->ArgumentCount(); ++i) {
+      arguments->Add(call->PushArgumentAt(i));
+    }
+    const ZoneGrowableArray<const ICData*> no_ic_data;
+    StaticCallInstr* static_call = new(Z) StaticCallInstr(
+        call->token_pos(),
+        target,
+        Array::ZoneHandle(Z, call->argument_names().raw()),
+        arguments,
+        no_ic_data);
+    // Keep the deoptimization target of the original call.
+    static_call->CopyDeoptIdFrom(*call);
+    call->ReplaceWith(static_call, NULL);
+    ++devirtualized_closure_calls_;
+    TRACE_INLINING(THR_Print("     Devirtualized closure call to %s\n",
+                             target.ToCString()));
+  }
+
   void InlineInstanceCalls() {
     const GrowableArray<CallSites::InstanceCallInfo>& call_info =
         inlining_call_sites_->instance_calls();
@@ -1305,6 +1377,8 @@ class CallSiteInliner : public ValueObject {
   bool inlined_recursive_call_;
   intptr_t inlining_depth_;
   intptr_t inlining_recursion_depth_;
+  intptr_t inlined_closure_calls_;
+  intptr_t devirtualized_closure_calls_;
   CallSites* collected_call_sites_;
   CallSites* inlining_call_sites_;
   GrowableArray<ParsedFunction*> function_cache_;
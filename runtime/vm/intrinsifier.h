@@ -48,6 +48,8 @@ class Intrinsifier : public AllStatic {
   GRAPH_INTRINSICS_LIST(DECLARE_FUNCTION)
 
 #undef DECLARE_FUNCTION
+
+  friend class IntrinsifierTestPeer;
 };
 
 }  // namespace dart
@@ -745,6 +745,7 @@ Isolate::Isolate(const Dart_IsolateFlags& api_flags)
       user_tag_(0),
       current_tag_(UserTag::null()),
       default_tag_(UserTag::null()),
+      dispatch_table_(Array::null()),
       class_table_(),
       single_step_(false),
       thread_registry_(new ThreadRegistry()),
@@ -791,6 +792,7 @@ Isolate::Isolate(const Dart_IsolateFlags& api_flags)
       trace_buffer_(NULL),
       tag_table_(GrowableObjectArray::null()),
       deoptimized_code_array_(GrowableObjectArray::null()),
+      compiler_profile_(Array::null()),
       background_compiler_(NULL),
       pending_service_extension_calls_(GrowableObjectArray::null()),
       registered_service_extension_handlers_(GrowableObjectArray::null()),
@@ -1622,6 +1624,7 @@ void Isolate::LowLevelShutdown() {
 
     ISOLATE_METRIC_LIST(ISOLATE_METRIC_PRINT);
 #undef ISOLATE_METRIC_PRINT
+    thread_registry()->PrintSafepointStats();
     THR_Print("\n");
   }
 }
@@ -1741,6 +1744,9 @@ void Isolate::VisitObjectPointers(ObjectPointerVisitor* visitor,
   // Visit the default tag which is stored in the isolate.
   visitor->VisitPointer(reinterpret_cast<RawObject**>(&default_tag_));
 
+  // Visit the dispatch table which is cached in the isolate.
+  visitor->VisitPointer(reinterpret_cast<RawObject**>(&dispatch_table_));
+
   // Visit the tag table which is stored in the isolate.
   visitor->VisitPointer(reinterpret_cast<RawObject**>(&tag_table_));
 
@@ -1752,6 +1758,9 @@ void Isolate::VisitObjectPointers(ObjectPointerVisitor* visitor,
   visitor->VisitPointer(
       reinterpret_cast<RawObject**>(&deoptimized_code_array_));
 
+  // Visit the compiler profile which is stored in the isolate.
+  visitor->VisitPointer(reinterpret_cast<RawObject**>(&compiler_profile_));
+
   // Visit the pending service extension calls.
   visitor->VisitPointer(
       reinterpret_cast<RawObject**>(&pending_service_extension_calls_));
@@ -1921,12 +1930,22 @@ void Isolate::set_ic_miss_code(const Code& code) {
 }
 
 
+void Isolate::set_dispatch_table(const Array& table) {
+  dispatch_table_ = table.raw();
+}
+
+
 void Isolate::set_deoptimized_code_array(const GrowableObjectArray& value) {
   ASSERT(Thread::Current()->IsMutatorThread());
   deoptimized_code_array_ = value.raw();
 }
 
 
+void Isolate::set_compiler_profile(const Array& value) {
+  compiler_profile_ = value.raw();
+}
+
+
 void Isolate::TrackDeoptimizedCode(const Code& code) {
   ASSERT(!code.IsNull());
   const GrowableObjectArray& deoptimized_code =
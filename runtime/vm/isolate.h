@@ -139,6 +139,10 @@ class Isolate : public BaseIsolate {
     return OFFSET_OF(Isolate, ic_miss_code_);
   }
 
+  static intptr_t dispatch_table_offset() {
+    return OFFSET_OF(Isolate, dispatch_table_);
+  }
+
   Dart_MessageNotifyCallback message_notify_callback() const {
     return message_notify_callback_;
   }
@@ -566,6 +570,7 @@ class Isolate : public BaseIsolate {
   void set_default_tag(const UserTag& tag);
 
   void set_ic_miss_code(const Code& code);
+  void set_dispatch_table(const Array& table);
 
   Metric* metrics_list_head() {
     return metrics_list_head_;
@@ -581,6 +586,9 @@ class Isolate : public BaseIsolate {
   void set_deoptimized_code_array(const GrowableObjectArray& value);
   void TrackDeoptimizedCode(const Code& code);
 
+  RawArray* compiler_profile() const { return compiler_profile_; }
+  void set_compiler_profile(const Array& value);
+
   bool compilation_allowed() const { return compilation_allowed_; }
   void set_compilation_allowed(bool allowed) {
     compilation_allowed_ = allowed;
@@ -716,6 +724,7 @@ class Isolate : public BaseIsolate {
   RawUserTag* current_tag_;
   RawUserTag* default_tag_;
   RawCode* ic_miss_code_;
+  RawArray* dispatch_table_;
   ClassTable class_table_;
   bool single_step_;
   bool skip_step_;  // skip the next single step.
@@ -778,6 +787,8 @@ class Isolate : public BaseIsolate {
 
   RawGrowableObjectArray* deoptimized_code_array_;
 
+  RawArray* compiler_profile_;
+
   // Background compilation.
   BackgroundCompiler* background_compiler_;
 
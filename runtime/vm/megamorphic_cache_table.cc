@@ -5,6 +5,8 @@
 #include "vm/megamorphic_cache_table.h"
 
 #include <stdlib.h>
+#include "vm/flags.h"
+#include "vm/log.h"
 #include "vm/object.h"
 #include "vm/object_store.h"
 #include "vm/stub_code.h"
@@ -12,6 +14,12 @@
 
 namespace dart {
 
+DEFINE_FLAG(bool, use_dispatch_table, false,
+    "Precompilation: look up megamorphic call targets in a global table "
+    "indexed by receiver class id plus selector offset (x64 only).");
+DECLARE_FLAG(int, max_polymorphic_checks);
+DECLARE_FLAG(bool, trace_precompiler);
+
 RawMegamorphicCache* MegamorphicCacheTable::Lookup(Isolate* isolate,
                                                    const String& name,
                                                    const Array& descriptor) {
@@ -81,6 +89,189 @@ void MegamorphicCacheTable::InitMissHandler(Isolate* isolate) {
 }
 
 
+// Returns the compiled target of a dynamic call of 'name' on an instance of
+// 'receiver_class', or null if the call does not resolve to a compiled
+// function that accepts the arguments. Unlike the resolver this does not
+// create method extractors or dispatchers.
+static RawFunction* LookupCompiledTarget(const Class& receiver_class,
+                                         const String& name,
+                                         const ArgumentsDescriptor& args_desc) {
+  Class& cls = Class::Handle(receiver_class.raw());
+  Function& function = Function::Handle();
+  while (!cls.IsNull()) {
+    function = cls.LookupDynamicFunction(name);
+    if (!function.IsNull()) {
+      break;
+    }
+    cls = cls.SuperClass();
+  }
+  if (function.IsNull() ||
+      !function.HasCode() ||
+      !function.AreValidArguments(args_desc, NULL)) {
+    return Function::null();
+  }
+  return function.raw();
+}
+
+
+// A selector's row: the class ids that understand the selector and their
+// targets, in increasing class id order.
+struct DispatchRow {
+  intptr_t cache_index;
+  intptr_t start;   // Index of the first entry in the flattened rows.
+  intptr_t length;
+};
+
+
+static int CompareRowLength(const DispatchRow* a, const DispatchRow* b) {
+  // Longer rows are harder to fit, place them first. Ties are broken by
+  // selector so that the table layout is deterministic.
+  if (a->length != b->length) {
+    return (a->length > b->length) ? -1 : 1;
+  }
+  return (a->cache_index < b->cache_index) ? -1 : 1;
+}
+
+
+// The dispatch table maps (receiver class id + selector offset) to a pair
+// (selector offset, target function). Rows of different selectors are
+// interleaved by row displacement: each row is shifted by the smallest
+// offset at which all its entries land on free slots. Offsets are unique
+// and non-zero, so the stored offset identifies the selector owning a slot
+// and a mismatch sends the lookup to the megamorphic cache.
+void MegamorphicCacheTable::BuildDispatchTable(Isolate* isolate) {
+  Zone* zone = Thread::Current()->zone();
+  const GrowableObjectArray& table = GrowableObjectArray::Handle(zone,
+      isolate->object_store()->megamorphic_cache_table());
+  if (table.IsNull()) {
+    isolate->object_store()->set_dispatch_table(Object::empty_array());
+    return;
+  }
+
+  // Collect the rows of all selectors called from megamorphic call sites.
+  ClassTable* class_table = isolate->class_table();
+  const intptr_t num_cids = class_table->NumCids();
+  GrowableArray<DispatchRow> rows(table.Length());
+  GrowableArray<intptr_t> row_cids;
+  GrowableArray<const Function*> row_targets;
+  MegamorphicCache& cache = MegamorphicCache::Handle(zone);
+  String& name = String::Handle(zone);
+  Array& descriptor = Array::Handle(zone);
+  Class& cls = Class::Handle(zone);
+  Function& target = Function::Handle(zone);
+  for (intptr_t i = 0; i < table.Length(); i++) {
+    cache ^= table.At(i);
+    cache.set_dispatch_offset(0);
+    name = cache.target_name();
+    descriptor = cache.arguments_descriptor();
+    ArgumentsDescriptor args_desc(descriptor);
+    DispatchRow row;
+    row.cache_index = i;
+    row.start = row_cids.length();
+    for (intptr_t cid = kInstanceCid; cid < num_cids; cid++) {
+      if (!class_table->HasValidClassAt(cid)) continue;
+      cls = class_table->At(cid);
+      // Only instantiated classes can be receivers.
+      if (!cls.is_allocated() || cls.is_abstract()) continue;
+      target = LookupCompiledTarget(cls, name, args_desc);
+      if (target.IsNull()) continue;
+      row_cids.Add(cid);
+      row_targets.Add(&Function::ZoneHandle(zone, target.raw()));
+    }
+    row.length = row_cids.length() - row.start;
+    // A call site only becomes megamorphic once it has seen more than
+    // --max_polymorphic_checks receiver classes, so shorter rows would never
+    // be used.
+    if (row.length > FLAG_max_polymorphic_checks) {
+      rows.Add(row);
+    } else {
+      row_cids.TruncateTo(row.start);
+      row_targets.TruncateTo(row.start);
+    }
+  }
+  rows.Sort(CompareRowLength);
+
+  // Place the rows. Offsets are biased by num_cids in 'offset_used' since
+  // they can be negative.
+  GrowableArray<bool> occupied;
+  GrowableArray<bool> offset_used;
+  intptr_t first_free = 0;
+  intptr_t num_entries = 0;
+  for (intptr_t r = 0; r < rows.length(); r++) {
+    const DispatchRow& row = rows[r];
+    const intptr_t min_cid = row_cids[row.start];
+    intptr_t offset = first_free - min_cid;
+    while (true) {
+      bool fits = (offset != 0);
+      if (fits && (offset + num_cids < offset_used.length())) {
+        fits = !offset_used[offset + num_cids];
+      }
+      for (intptr_t j = 0; fits && (j < row.length); j++) {
+        const intptr_t index = row_cids[row.start + j] + offset;
+        fits = (index >= occupied.length()) || !occupied[index];
+      }
+      if (fits) break;
+      offset++;
+    }
+    for (intptr_t j = 0; j < row.length; j++) {
+      const intptr_t index = row_cids[row.start + j] + offset;
+      while (occupied.length() <= index) {
+        occupied.Add(false);
+      }
+      occupied[index] = true;
+    }
+    while (offset_used.length() <= offset + num_cids) {
+      offset_used.Add(false);
+    }
+    offset_used[offset + num_cids] = true;
+    while ((first_free < occupied.length()) && occupied[first_free]) {
+      first_free++;
+    }
+    num_entries += row.length;
+    cache ^= table.At(row.cache_index);
+    cache.set_dispatch_offset(offset);
+  }
+
+  // Materialize the table as (offset, target) pairs.
+  const Array& dispatch_table = Array::Handle(zone,
+      Array::New(occupied.length() * kDispatchEntryLength, Heap::kOld));
+  Smi& offset_smi = Smi::Handle(zone);
+  for (intptr_t r = 0; r < rows.length(); r++) {
+    const DispatchRow& row = rows[r];
+    cache ^= table.At(row.cache_index);
+    offset_smi = Smi::New(cache.dispatch_offset());
+    for (intptr_t j = 0; j < row.length; j++) {
+      const intptr_t index =
+          (row_cids[row.start + j] + offset_smi.Value()) * kDispatchEntryLength;
+      dispatch_table.SetAt(index + kDispatchOffsetIndex, offset_smi);
+      dispatch_table.SetAt(index + kDispatchTargetIndex,
+                           *row_targets[row.start + j]);
+    }
+  }
+  isolate->object_store()->set_dispatch_table(dispatch_table);
+
+  // Drop the caches that were only created to register their selector and
+  // did not get a row, so that they do not end up in the snapshot. A call
+  // site that becomes megamorphic at run time creates its cache on demand.
+  const GrowableObjectArray& used_caches = GrowableObjectArray::Handle(zone,
+      GrowableObjectArray::New(rows.length(), Heap::kOld));
+  for (intptr_t i = 0; i < table.Length(); i++) {
+    cache ^= table.At(i);
+    if ((cache.dispatch_offset() != 0) || (cache.filled_entry_count() > 0)) {
+      used_caches.Add(cache, Heap::kOld);
+    }
+  }
+  isolate->object_store()->set_megamorphic_cache_table(used_caches);
+
+  if (FLAG_trace_precompiler) {
+    THR_Print("Dispatch table: %" Pd " selectors, %" Pd " entries, "
+              "%" Pd " slots (%" Pd "%% filled).\n",
+              rows.length(), num_entries, occupied.length(),
+              occupied.is_empty() ? 0 : (num_entries * 100) / occupied.length());
+  }
+}
+
+
 void MegamorphicCacheTable::PrintSizes(Isolate* isolate) {
   StackZone zone(Thread::Current());
   intptr_t size = 0;
@@ -22,6 +22,13 @@ class String;
 
 class MegamorphicCacheTable : public AllStatic {
  public:
+  // Layout of an entry in the dispatch table.
+  enum {
+    kDispatchOffsetIndex,
+    kDispatchTargetIndex,
+    kDispatchEntryLength,
+  };
+
   static RawFunction* miss_handler(Isolate* isolate);
   static void InitMissHandler(Isolate* isolate);
 
@@ -29,6 +36,13 @@ class MegamorphicCacheTable : public AllStatic {
                                      const String& name,
                                      const Array& descriptor);
 
+  // Builds the isolate's dispatch table for the selectors of all megamorphic
+  // caches and assigns each cache its row offset. Selectors understood by no
+  // more than --max_polymorphic_checks classes get no row, and their unused
+  // caches are dropped. Requires a closed class hierarchy and compiled
+  // targets, i.e. it is only used by the precompiler.
+  static void BuildDispatchTable(Isolate* isolate);
+
   static void PrintSizes(Isolate* isolate);
 };
 
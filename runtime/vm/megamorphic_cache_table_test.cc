@@ -0,0 +1,132 @@
+// Copyright (c) 2016, the Dart project authors.  Please see the AUTHORS file
+// for details. All rights reserved. Use of this source code is governed by a
+// BSD-style license that can be found in the LICENSE file.
+
+#include "platform/assert.h"
+#include "platform/text_buffer.h"
+#include "vm/class_finalizer.h"
+#include "vm/compiler.h"
+#include "vm/dart_entry.h"
+#include "vm/globals.h"
+#include "vm/megamorphic_cache_table.h"
+#include "vm/object_store.h"
+#include "vm/symbols.h"
+#include "vm/unit_test.h"
+
+namespace dart {
+
+DECLARE_FLAG(int, max_polymorphic_checks);
+
+static RawClass* GetClass(const Library& lib, const char* name) {
+  const Class& cls = Class::Handle(
+      lib.LookupClass(String::Handle(Symbols::New(name))));
+  EXPECT(!cls.IsNull());
+  return cls.raw();
+}
+
+
+// Looks up the target of a call of the cache's selector on an instance of
+// class 'cid' the way the megamorphic lookup stub does. Returns null if the
+// lookup has to fall back to probing the cache.
+static RawFunction* LookupDispatchTable(const Array& table,
+                                        const MegamorphicCache& cache,
+                                        intptr_t cid) {
+  const intptr_t offset = cache.dispatch_offset();
+  const intptr_t index =
+      (cid + offset) * MegamorphicCacheTable::kDispatchEntryLength;
+  if ((offset == 0) || (index < 0) || (index >= table.Length())) {
+    return Function::null();
+  }
+  const Object& entry_offset = Object::Handle(
+      table.At(index + MegamorphicCacheTable::kDispatchOffsetIndex));
+  if (entry_offset.raw() != Smi::New(offset)) {
+    return Function::null();
+  }
+  return Function::RawCast(
+      table.At(index + MegamorphicCacheTable::kDispatchTargetIndex));
+}
+
+
+TEST_CASE(MegamorphicCacheTable_DispatchTable) {
+  // C1..Cn override 'foo' of C0 and each define 'baz', where n is the number
+  // of receiver classes a polymorphic call site handles. 'foo' and 'bar' are
+  // understood by one more class than that and get rows, 'baz' does not.
+  const intptr_t num_classes = FLAG_max_polymorphic_checks + 1;
+  TextBuffer script(1024);
+  script.Printf("class C0 { foo() => 0; bar() => 0; }\n");
+  for (intptr_t i = 1; i < num_classes; i++) {
+    script.Printf("class C%" Pd " extends C0 { foo() => %" Pd "; "
+                  "baz() => %" Pd "; }\n", i, i, i);
+  }
+  script.Printf("abstract class G { foo(); bar(); baz(); }\n");
+
+  TestCase::LoadTestScript(script.buf(), NULL);
+  EXPECT(ClassFinalizer::ProcessPendingClasses());
+  const Library& lib = Library::Handle(Library::LookupLibrary(
+      String::Handle(String::New(TestCase::url()))));
+  EXPECT(!lib.IsNull());
+
+  Zone* zone = thread->zone();
+  Class& cls = Class::Handle();
+  for (intptr_t i = 0; i < num_classes; i++) {
+    cls = GetClass(lib, OS::SCreate(zone, "C%" Pd, i));
+    EXPECT(Error::Handle(Compiler::CompileAllFunctions(cls)).IsNull());
+    cls.set_is_allocated(true);
+  }
+  cls = GetClass(lib, "G");
+  cls.set_is_allocated(true);
+
+  Isolate* isolate = thread->isolate();
+  const Array& descriptor = Array::Handle(ArgumentsDescriptor::New(1));
+  const String& foo_name = String::Handle(Symbols::New("foo"));
+  const String& bar_name = String::Handle(Symbols::New("bar"));
+  const String& baz_name = String::Handle(Symbols::New("baz"));
+  const MegamorphicCache& foo_cache = MegamorphicCache::Handle(
+      MegamorphicCacheTable::Lookup(isolate, foo_name, descriptor));
+  const MegamorphicCache& bar_cache = MegamorphicCache::Handle(
+      MegamorphicCacheTable::Lookup(isolate, bar_name, descriptor));
+  const MegamorphicCache& baz_cache = MegamorphicCache::Handle(
+      MegamorphicCacheTable::Lookup(isolate, baz_name, descriptor));
+
+  MegamorphicCacheTable::BuildDispatchTable(isolate);
+
+  // Rows get distinct non-zero offsets, 'baz' gets none and its cache is
+  // dropped.
+  EXPECT(foo_cache.dispatch_offset() != 0);
+  EXPECT(bar_cache.dispatch_offset() != 0);
+  EXPECT(foo_cache.dispatch_offset() != bar_cache.dispatch_offset());
+  EXPECT_EQ(0, baz_cache.dispatch_offset());
+  const GrowableObjectArray& caches = GrowableObjectArray::Handle(
+      isolate->object_store()->megamorphic_cache_table());
+  EXPECT_EQ(2, caches.Length());
+  EXPECT_EQ(foo_cache.raw(),
+            MegamorphicCacheTable::Lookup(isolate, foo_name, descriptor));
+  EXPECT(MegamorphicCacheTable::Lookup(isolate, baz_name, descriptor) !=
+         baz_cache.raw());
+
+  // Every allocated class finds the target the resolver would pick.
+  const Array& table = Array::Handle(
+      isolate->object_store()->dispatch_table());
+  const Class& base = Class::Handle(GetClass(lib, "C0"));
+  Function& target = Function::Handle();
+  for (intptr_t i = 0; i < num_classes; i++) {
+    cls = GetClass(lib, OS::SCreate(zone, "C%" Pd, i));
+    target = LookupDispatchTable(table, foo_cache, cls.id());
+    EXPECT(!target.IsNull());
+    EXPECT_EQ(cls.raw(), target.Owner());
+    EXPECT(String::Handle(target.name()).Equals("foo"));
+    target = LookupDispatchTable(table, bar_cache, cls.id());
+    EXPECT(!target.IsNull());
+    EXPECT_EQ(base.raw(), target.Owner());
+    EXPECT(String::Handle(target.name()).Equals("bar"));
+  }
+
+  // Abstract classes and classes that do not understand the selector miss
+  // in the table.
+  cls = GetClass(lib, "G");
+  EXPECT(LookupDispatchTable(table, foo_cache, cls.id()) == Function::null());
+  cls = isolate->object_store()->object_class();
+  EXPECT(LookupDispatchTable(table, foo_cache, cls.id()) == Function::null());
+}
+
+}  // namespace dart
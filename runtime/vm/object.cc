@@ -4460,6 +4460,20 @@ bool TypeArguments::TypeTest(TypeTestKind test_kind,
 }
 
 
+// Traits for looking up instantiations by their canonical instantiator type
+// arguments, which may be null.
+class InstantiatorTypeArgumentsTraits {
+ public:
+  static bool IsMatch(const Object& a, const Object& b) {
+    return a.raw() == b.raw();
+  }
+  static uword Hash(const Object& key) {
+    return key.IsNull() ? 0 : TypeArguments::Cast(key).Hash();
+  }
+};
+typedef UnorderedHashMap<InstantiatorTypeArgumentsTraits> InstantiationsMap;
+
+
 void TypeArguments::PrintJSONImpl(JSONStream* stream, bool ref) const {
   JSONObject jsobj(stream);
   // The index in the canonical_type_arguments table cannot be used as part of
@@ -4502,6 +4516,22 @@ void TypeArguments::PrintJSONImpl(JSONStream* stream, bool ref) const {
       instantiation.AddProperty("instantiated", type_args, true);
       i += 2;
     }
+    // Only a full linear part is followed by the instantiations map, the
+    // slot after a shorter one is padding of the grown array.
+    if ((i >= kMaxLinearInstantiations * 2) &&
+        (prior_instantiations.Length() > (i + 1))) {
+      InstantiationsMap map(Array::RawCast(prior_instantiations.At(i + 1)));
+      InstantiationsMap::Iterator it(&map);
+      while (it.MoveNext()) {
+        const intptr_t entry = it.Current();
+        JSONObject instantiation(&jsarr);
+        type_args ^= map.GetKey(entry);
+        instantiation.AddProperty("instantiator", type_args, true);
+        type_args ^= map.GetPayload(entry, 0);
+        instantiation.AddProperty("instantiated", type_args, true);
+      }
+      map.Release();
+    }
   }
 }
 
@@ -4520,7 +4550,14 @@ intptr_t TypeArguments::NumInstantiations() const {
   while (prior_instantiations.At(i) != Smi::New(StubCode::kNoInstantiator)) {
     i += 2;
   }
-  return i/2;
+  intptr_t num_instantiations = i / 2;
+  if ((i >= kMaxLinearInstantiations * 2) &&
+      (prior_instantiations.Length() > (i + 1))) {
+    InstantiationsMap map(Array::RawCast(prior_instantiations.At(i + 1)));
+    num_instantiations += map.NumOccupied();
+    map.Release();
+  }
+  return num_instantiations;
 }
 
 
@@ -4779,6 +4816,19 @@ RawTypeArguments* TypeArguments::InstantiateAndCanonicalizeFrom(
     }
     index += 2;
   }
+  // The linearly searched part of the cache, which is also scanned by
+  // generated code, is bounded. Further instantiations are kept in a hash map
+  // stored right after the sentinel.
+  const bool use_map = (index >= kMaxLinearInstantiations * 2);
+  if (use_map && (prior_instantiations.Length() > (index + 1))) {
+    InstantiationsMap map(Array::RawCast(prior_instantiations.At(index + 1)));
+    TypeArguments& cached = TypeArguments::Handle();
+    cached ^= map.GetOrNull(instantiator_type_arguments);
+    map.Release();
+    if (!cached.IsNull()) {
+      return cached.raw();
+    }
+  }
   // Cache lookup failed. Instantiate the type arguments.
   TypeArguments& result = TypeArguments::Handle();
   result = InstantiateFrom(
@@ -4791,6 +4841,21 @@ RawTypeArguments* TypeArguments::InstantiateAndCanonicalizeFrom(
   // InstantiateAndCanonicalizeFrom is not reentrant. It cannot have been called
   // indirectly, so the prior_instantiations array cannot have grown.
   ASSERT(prior_instantiations.raw() == instantiations());
+  if (use_map) {
+    // Add instantiator and result to the instantiations map.
+    if (prior_instantiations.Length() == (index + 1)) {
+      prior_instantiations =
+          Array::Grow(prior_instantiations, index + 2, Heap::kOld);
+      set_instantiations(prior_instantiations);
+      prior_instantiations.SetAt(index + 1, Array::Handle(
+          HashTables::New<InstantiationsMap>(kMaxLinearInstantiations,
+                                             Heap::kOld)));
+    }
+    InstantiationsMap map(Array::RawCast(prior_instantiations.At(index + 1)));
+    map.UpdateOrInsert(instantiator_type_arguments, result);
+    prior_instantiations.SetAt(index + 1, map.Release());
+    return result.raw();
+  }
   // Add instantiator and result to instantiations array.
   intptr_t length = prior_instantiations.Length();
   if ((index + 2) >= length) {
@@ -8246,9 +8311,10 @@ class CompressedTokenStreamData : public ValueObject {
   static const bool kPrintTokenObjects = false;
 
   CompressedTokenStreamData(const GrowableObjectArray& ta,
-                            CompressedTokenMap* map) :
+                            CompressedTokenMap* map,
+                            intptr_t num_tokens) :
       buffer_(NULL),
-      stream_(&buffer_, Reallocate, kInitialBufferSize),
+      stream_(&buffer_, Reallocate, InitialBufferSize(num_tokens)),
       token_objects_(ta),
       tokens_(map),
       value_(Object::Handle()),
@@ -8316,6 +8382,11 @@ class CompressedTokenStreamData : public ValueObject {
     stream_.WriteUnsigned(value + Token::kNumTokens);
   }
 
+  // Most tokens encode in one or two bytes.
+  static intptr_t InitialBufferSize(intptr_t num_tokens) {
+    return Utils::Maximum(kInitialBufferSize, num_tokens * 2);
+  }
+
   static uint8_t* Reallocate(uint8_t* ptr,
                              intptr_t old_size,
                              intptr_t new_size) {
@@ -8363,9 +8434,9 @@ RawTokenStream* TokenStream::New(const Scanner::GrowableTokenStream& tokens,
                                             Heap::kOld);
   }
   CompressedTokenMap map(token_objects_map.raw());
-  CompressedTokenStreamData data(token_objects, &map);
-
   intptr_t len = tokens.length();
+  CompressedTokenStreamData data(token_objects, &map, len);
+
   for (intptr_t i = 0; i < len; i++) {
     Scanner::TokenDescriptor token = tokens[i];
     if (token.kind == Token::kIDENT) {  // Identifier token.
@@ -13576,6 +13647,12 @@ RawCode* Code::LookupCodeInIsolate(Isolate* isolate, uword pc) {
     return Code::null();
   }
   NoSafepointScope no_safepoint;
+  // Checking the executable pages is cheap compared to visiting every object
+  // in the data pages, and rules out most pcs that belong to the other heap
+  // (see FindCode) or to no Dart code at all.
+  if (!isolate->heap()->CodeContains(pc)) {
+    return Code::null();
+  }
   SlowFindRawCodeVisitor visitor(pc);
   RawObject* needle = isolate->heap()->FindOldObject(&visitor);
   if (needle != Code::null()) {
@@ -13880,11 +13957,22 @@ RawStackmap* Code::GetStackmap(
   // frame slots which are marked as having objects.
   *maps = stackmaps();
   *map = Stackmap::null();
-  for (intptr_t i = 0; i < maps->Length(); i++) {
-    *map ^= maps->At(i);
+  // The stack maps are sorted by pc offset (see StackmapTableBuilder), so
+  // use a binary search: this is on the path of every frame visited by the
+  // GC and the profiler.
+  intptr_t low = 0;
+  intptr_t high = maps->Length() - 1;
+  while (low <= high) {
+    const intptr_t mid = low + (high - low) / 2;
+    *map ^= maps->At(mid);
     ASSERT(!map->IsNull());
-    if (map->PcOffset() == pc_offset) {
+    const uint32_t map_pc_offset = map->PcOffset();
+    if (map_pc_offset == pc_offset) {
       return map->raw();  // We found a stack map for this frame.
+    } else if (map_pc_offset < pc_offset) {
+      low = mid + 1;
+    } else {
+      high = mid - 1;
     }
   }
   ASSERT(!is_optimized());
@@ -14259,6 +14347,18 @@ void MegamorphicCache::set_mask(intptr_t mask) const {
 }
 
 
+// Like the mask, the offset is smi-tagged so that generated code can add it
+// to the smi-tagged receiver class ID directly.
+intptr_t MegamorphicCache::dispatch_offset() const {
+  return Smi::Value(raw_ptr()->dispatch_offset_);
+}
+
+
+void MegamorphicCache::set_dispatch_offset(intptr_t offset) const {
+  StoreSmi(&raw_ptr()->dispatch_offset_, Smi::New(offset));
+}
+
+
 intptr_t MegamorphicCache::filled_entry_count() const {
   return raw_ptr()->filled_entry_count_;
 }
@@ -14288,6 +14388,7 @@ RawMegamorphicCache* MegamorphicCache::New() {
     result ^= raw;
   }
   result.set_filled_entry_count(0);
+  result.set_dispatch_offset(0);
   return result.raw();
 }
 
@@ -14314,6 +14415,7 @@ RawMegamorphicCache* MegamorphicCache::New(const String& target_name,
   result.set_target_name(target_name);
   result.set_arguments_descriptor(arguments_descriptor);
   result.set_filled_entry_count(0);
+  result.set_dispatch_offset(0);
   return result.raw();
 }
 
@@ -14416,8 +14518,20 @@ void SubtypeTestCache::set_cache(const Array& value) const {
 
 intptr_t SubtypeTestCache::NumberOfChecks() const {
   NoSafepointScope no_safepoint;
-  // Do not count the sentinel;
-  return (Smi::Value(cache()->ptr()->length_) / kTestEntryLength) - 1;
+  // The cache array may have spare capacity. The checks end at the first
+  // entry without an instance class id or function, which the type test stubs
+  // also treat as the end of the cache. Do not count that sentinel.
+  RawArray* data = cache();
+  const intptr_t num_entries = Smi::Value(data->ptr()->length_) /
+                               kTestEntryLength;
+  intptr_t num_checks = 0;
+  while ((num_checks < num_entries) &&
+         (data->ptr()->data()[num_checks * kTestEntryLength +
+                              kInstanceClassIdOrFunction] != Object::null())) {
+    num_checks++;
+  }
+  ASSERT(num_checks < num_entries);  // Always at least a sentinel.
+  return num_checks;
 }
 
 
@@ -14428,10 +14542,14 @@ void SubtypeTestCache::AddCheck(
     const Bool& test_result) const {
   intptr_t old_num = NumberOfChecks();
   Array& data = Array::Handle(cache());
-  intptr_t new_len = data.Length() + kTestEntryLength;
-  data = Array::Grow(data, new_len);
-  set_cache(data);
   intptr_t data_pos = old_num * kTestEntryLength;
+  if ((data_pos + 2 * kTestEntryLength) > data.Length()) {
+    // Grow the cache geometrically instead of by one entry per added check,
+    // keeping room for the terminating sentinel entry.
+    intptr_t new_len = (old_num + 1) * 2 * kTestEntryLength;
+    data = Array::Grow(data, new_len, Heap::kOld);
+    set_cache(data);
+  }
   data.SetAt(data_pos + kInstanceClassIdOrFunction,
              instance_class_id_or_function);
   data.SetAt(data_pos + kInstanceTypeArguments, instance_type_arguments);
@@ -1631,6 +1631,11 @@ class TypeArguments : public Object {
     return OFFSET_OF(RawTypeArguments, instantiations_);
   }
 
+  // The number of instantiations kept in the linearly searched part of the
+  // instantiations cache, which generated code probes inline. Further
+  // instantiations are kept in a hash map following the sentinel.
+  static const intptr_t kMaxLinearInstantiations = 8;
+
   static const intptr_t kBytesPerElement = kWordSize;
   static const intptr_t kMaxElements = kSmiMax / kBytesPerElement;
 
@@ -4733,6 +4738,11 @@ class MegamorphicCache : public Object {
   intptr_t mask() const;
   void set_mask(intptr_t mask) const;
 
+  // Offset of this selector's row in the isolate's dispatch table (see
+  // MegamorphicCacheTable::BuildDispatchTable), or 0 if it has no row.
+  intptr_t dispatch_offset() const;
+  void set_dispatch_offset(intptr_t offset) const;
+
   RawString* target_name() const {
     return raw_ptr()->target_name_;
   }
@@ -4753,6 +4763,9 @@ class MegamorphicCache : public Object {
   static intptr_t arguments_descriptor_offset() {
     return OFFSET_OF(RawMegamorphicCache, args_descriptor_);
   }
+  static intptr_t dispatch_offset_offset() {
+    return OFFSET_OF(RawMegamorphicCache, dispatch_offset_);
+  }
 
   static RawMegamorphicCache* New(const String& target_name,
                                   const Array& arguments_descriptor);
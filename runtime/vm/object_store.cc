@@ -95,7 +95,8 @@ ObjectStore::ObjectStore()
     token_objects_map_(Array::null()),
     megamorphic_cache_table_(GrowableObjectArray::null()),
     megamorphic_miss_code_(Code::null()),
-    megamorphic_miss_function_(Function::null()) {
+    megamorphic_miss_function_(Function::null()),
+    dispatch_table_(Array::null()) {
   for (RawObject** current = from(); current <= to(); current++) {
     ASSERT(*current == Object::null());
   }
@@ -483,6 +483,11 @@ class ObjectStore {
     megamorphic_miss_function_ = func.raw();
   }
 
+  RawArray* dispatch_table() const { return dispatch_table_; }
+  void set_dispatch_table(const Array& value) {
+    dispatch_table_ = value.raw();
+  }
+
   // Visit all object pointers.
   void VisitObjectPointers(ObjectPointerVisitor* visitor);
 
@@ -583,8 +588,9 @@ class ObjectStore {
   RawGrowableObjectArray* megamorphic_cache_table_;
   RawCode* megamorphic_miss_code_;
   RawFunction* megamorphic_miss_function_;
+  RawArray* dispatch_table_;
   RawObject** to() {
-    return reinterpret_cast<RawObject**>(&megamorphic_miss_function_);
+    return reinterpret_cast<RawObject**>(&dispatch_table_);
   }
 
   friend class FullSnapshotWriter;
@@ -6,6 +6,7 @@
 
 #include "vm/assembler.h"
 #include "vm/class_finalizer.h"
+#include "vm/code_patcher.h"
 #include "vm/dart_api_impl.h"
 #include "vm/dart_entry.h"
 #include "vm/debugger.h"
@@ -2736,6 +2737,44 @@ TEST_CASE(CodeImmutability) {
 }
 
 
+// Test that instructions made writable in a batch can be written and are
+// executable again once the batch scope is left.
+TEST_CASE(CodeBatchPatching) {
+  extern void GenerateIncrement(Assembler* assembler);
+  const intptr_t kNumFunctions = 3;
+  Function* functions[kNumFunctions];
+  Code* codes[kNumFunctions];
+  for (intptr_t i = 0; i < kNumFunctions; i++) {
+    Assembler _assembler_;
+    GenerateIncrement(&_assembler_);
+    functions[i] = &Function::Handle(CreateFunction("Test_Code"));
+    codes[i] = &Code::Handle(Code::FinalizeCode(*functions[i], &_assembler_));
+    functions[i]->AttachCode(*codes[i]);
+  }
+  {
+    WritableInstructionsBatchScope writable;
+    Instructions& instructions = Instructions::Handle();
+    for (intptr_t i = 0; i < kNumFunctions; i++) {
+      instructions = codes[i]->instructions();
+      writable.MakeWritable(instructions.EntryPoint(), instructions.size());
+      // Adding the same region again must be harmless.
+      writable.MakeWritable(instructions.EntryPoint(), instructions.size());
+    }
+    for (intptr_t i = 0; i < kNumFunctions; i++) {
+      instructions = codes[i]->instructions();
+      volatile uint8_t* entry =
+          reinterpret_cast<volatile uint8_t*>(instructions.EntryPoint());
+      *entry = *entry;
+    }
+  }
+  for (intptr_t i = 0; i < kNumFunctions; i++) {
+    const Object& result = Object::Handle(
+        DartEntry::InvokeFunction(*functions[i], Array::empty_array()));
+    EXPECT_EQ(1, Smi::Cast(result).Value());
+  }
+}
+
+
 // Test for Embedded String object in the instructions.
 TEST_CASE(EmbedStringInCode) {
   extern void GenerateEmbedStringInCode(Assembler* assembler, const char* str);
@@ -3102,6 +3141,21 @@ TEST_CASE(SubtypeTestCache) {
   EXPECT_EQ(targ_0.raw(), test_targ_0.raw());
   EXPECT_EQ(targ_1.raw(), test_targ_1.raw());
   EXPECT_EQ(Bool::True().raw(), test_result.raw());
+  // Adding more checks grows the cache while keeping the earlier checks.
+  const intptr_t kNumChecks = 20;
+  Object& class_id = Object::Handle();
+  for (intptr_t i = 1; i < kNumChecks; i++) {
+    class_id = Smi::New(empty_class.id() + i);
+    cache.AddCheck(class_id, targ_0, targ_1, Bool::False());
+    EXPECT_EQ(i + 1, cache.NumberOfChecks());
+  }
+  for (intptr_t i = 0; i < kNumChecks; i++) {
+    cache.GetCheck(
+        i, &test_class_id_or_fun, &test_targ_0, &test_targ_1, &test_result);
+    EXPECT_EQ(Smi::New(empty_class.id() + i), test_class_id_or_fun.raw());
+    EXPECT_EQ((i == 0) ? Bool::True().raw() : Bool::False().raw(),
+              test_result.raw());
+  }
 }
 
 
@@ -4684,4 +4738,77 @@ TEST_CASE(String_IdentifierPrettyName) {
   }
 }
 
+
+static intptr_t CountSubstrings(const char* str, const char* sub) {
+  intptr_t count = 0;
+  for (const char* p = strstr(str, sub); p != NULL; p = strstr(p + 1, sub)) {
+    count++;
+  }
+  return count;
+}
+
+
+TEST_CASE(TypeArguments_InstantiationsCache) {
+  const char* kScriptChars =
+      "class A<T> {}\n"
+      "class C0 {}\n"
+      "class C1 {}\n"
+      "class C2 {}\n"
+      "class C3 {}\n"
+      "class C4 {}\n"
+      "class C5 {}\n"
+      "class C6 {}\n"
+      "class C7 {}\n"
+      "class C8 {}\n"
+      "class C9 {}\n";
+  TestCase::LoadTestScript(kScriptChars, NULL);
+  EXPECT(ClassFinalizer::ProcessPendingClasses());
+  const Library& lib = Library::Handle(Library::LookupLibrary(
+      String::Handle(String::New(TestCase::url()))));
+  EXPECT(!lib.IsNull());
+  const Class& cls_a = Class::Handle(
+      lib.LookupClass(String::Handle(Symbols::New("A"))));
+  EXPECT(!cls_a.IsNull());
+  const TypeArguments& type_params =
+      TypeArguments::Handle(cls_a.type_parameters());
+  EXPECT(!type_params.IsInstantiated());
+
+  // Fill the linear part of the cache partially, then past its end so that
+  // the remaining instantiations go to the map.
+  const intptr_t kNumInstantiators = 10;
+  const intptr_t kNumLinear = 3;
+  Class& cls = Class::Handle();
+  Type& type = Type::Handle();
+  TypeArguments& instantiator = TypeArguments::Handle();
+  TypeArguments& instantiated = TypeArguments::Handle();
+  char name[8];
+  for (intptr_t i = 0; i < kNumInstantiators; i++) {
+    OS::SNPrint(name, sizeof(name), "C%" Pd "", i);
+    cls = lib.LookupClass(String::Handle(Symbols::New(name)));
+    EXPECT(!cls.IsNull());
+    type = Type::NewNonParameterizedType(cls);
+    instantiator = TypeArguments::New(1);
+    instantiator.SetTypeAt(0, type);
+    instantiator = instantiator.Canonicalize();
+    Error& bound_error = Error::Handle();
+    instantiated =
+        type_params.InstantiateAndCanonicalizeFrom(instantiator, &bound_error);
+    EXPECT(bound_error.IsNull());
+    EXPECT_EQ(type.raw(), instantiated.TypeAt(0));
+    // Looking up the same instantiator again hits the cache.
+    EXPECT_EQ(instantiated.raw(),
+              type_params.InstantiateAndCanonicalizeFrom(instantiator, NULL));
+
+    if ((i + 1 == kNumLinear) || (i + 1 == kNumInstantiators)) {
+      // The slot after the sentinel of a partially filled linear part is
+      // padding, not the instantiations map.
+      EXPECT_EQ(i + 1, type_params.NumInstantiations());
+      JSONStream js;
+      type_params.PrintJSON(&js, false);
+      EXPECT_EQ(i + 1, CountSubstrings(js.ToCString(), "\"instantiator\""));
+    }
+  }
+  EXPECT_LT(TypeArguments::kMaxLinearInstantiations, kNumInstantiators);
+}
+
 }  // namespace dart
@@ -5,12 +5,24 @@
 #include "vm/os_thread.h"
 
 #include "vm/atomic.h"
+#include "vm/flags.h"
 #include "vm/lockers.h"
 #include "vm/log.h"
+#include "vm/os.h"
 #include "vm/thread_interrupter.h"
 
+#if defined(_MSC_VER)
+#include <intrin.h>  // NOLINT
+#endif
+
 namespace dart {
 
+DEFINE_FLAG(int, mutex_spin_count, 100,
+            "Number of times a contended mutex is retried before the thread "
+            "blocks. Ignored on Windows.");
+DEFINE_FLAG(bool, profile_mutex_contention, false,
+            "Collect contention statistics for named mutexes.");
+
 // The single thread local key which stores all the thread local data
 // for a thread.
 ThreadLocalKey OSThread::thread_key_ = kUnsetThreadLocalKey;
@@ -274,4 +286,105 @@ OSThread* OSThreadIterator::Next() {
   return current;
 }
 
+MutexContentionSite MutexContentionSite::sites_[kMaxSites];
+uword MutexContentionSite::num_sites_ = 0;
+uword MutexContentionSite::sites_lock_ = 0;
+
+
+MutexContentionSite* MutexContentionSite::Register(const char* name) {
+  ASSERT(name != NULL);
+  // Sites are registered while mutexes are constructed, possibly before the
+  // VM is initialized, so the table is guarded by a simple spin lock.
+  while (AtomicOperations::CompareAndSwapWord(&sites_lock_, 0, 1) != 0) {
+  }
+  MutexContentionSite* site = NULL;
+  for (uword i = 0; i < num_sites_; i++) {
+    if (strcmp(sites_[i].name_, name) == 0) {
+      site = &sites_[i];
+      break;
+    }
+  }
+  if ((site == NULL) && (num_sites_ < static_cast<uword>(kMaxSites))) {
+    site = &sites_[num_sites_];
+    site->name_ = name;
+    // Publish the site only once its name is set.
+    AtomicOperations::FetchAndIncrement(&num_sites_);
+  }
+  AtomicOperations::CompareAndSwapWord(&sites_lock_, 1, 0);
+  return site;
+}
+
+
+intptr_t MutexContentionSite::NumSites() {
+  return AtomicOperations::LoadRelaxed(&num_sites_);
+}
+
+
+MutexContentionSite* MutexContentionSite::SiteAt(intptr_t index) {
+  ASSERT((index >= 0) && (index < NumSites()));
+  return &sites_[index];
+}
+
+
+void MutexContentionSite::RecordWait(int64_t micros) {
+  ASSERT(micros >= 0);
+  intptr_t bucket = 0;
+  while ((bucket < (kNumWaitTimeBuckets - 1)) &&
+         (micros >= (static_cast<int64_t>(1) << bucket))) {
+    bucket++;
+  }
+  AtomicOperations::FetchAndIncrementBy(&wait_time_histogram_[bucket], 1);
+  AtomicOperations::FetchAndIncrementBy(&contended_count_, 1);
+  AtomicOperations::FetchAndIncrementBy(&wait_micros_,
+                                        static_cast<intptr_t>(micros));
+  // Other threads may be recording waits at the same site.
+  const uword wait = static_cast<uword>(micros);
+  uword max_wait = AtomicOperations::LoadRelaxed(&max_wait_micros_);
+  while (wait > max_wait) {
+    const uword old_max_wait = AtomicOperations::CompareAndSwapWord(
+        &max_wait_micros_, max_wait, wait);
+    if (old_max_wait == max_wait) {
+      break;
+    }
+    max_wait = old_max_wait;
+  }
+}
+
+
+static inline void SpinPause() {
+#if defined(HOST_ARCH_IA32) || defined(HOST_ARCH_X64)
+#if defined(_MSC_VER)
+  _mm_pause();
+#else
+  __asm__ __volatile__("pause");
+#endif
+#elif defined(HOST_ARCH_ARM64)
+  __asm__ __volatile__("yield");
+#endif
+}
+
+
+void Mutex::LockContended() {
+  const bool profile = FLAG_profile_mutex_contention && (site_ != NULL);
+  const int64_t start = profile ? OS::GetCurrentMonotonicMicros() : 0;
+  bool acquired = false;
+#if !defined(TARGET_OS_WINDOWS)
+  // Windows mutexes are semaphores, so TryLock is a kernel call there and
+  // retrying it is no cheaper than blocking.
+  for (intptr_t i = 0; i < FLAG_mutex_spin_count; i++) {
+    SpinPause();
+    if (TryLock()) {
+      acquired = true;
+      break;
+    }
+  }
+#endif
+  if (!acquired) {
+    LockBlocking();
+  }
+  if (profile) {
+    site_->RecordWait(OS::GetCurrentMonotonicMicros() - start);
+  }
+}
+
 }  // namespace dart
@@ -261,9 +261,56 @@ class OSThreadIterator : public ValueObject {
 };
 
 
+// Contention statistics for a lock site, i.e. all mutexes created with the
+// same name. Only collected under --profile_mutex_contention.
+class MutexContentionSite {
+ public:
+  static const intptr_t kNumWaitTimeBuckets = 16;
+
+  const char* name() const { return name_; }
+  intptr_t contended_count() const { return contended_count_; }
+  intptr_t wait_micros() const { return wait_micros_; }
+  intptr_t max_wait_micros() const {
+    return static_cast<intptr_t>(max_wait_micros_);
+  }
+
+  // Bucket i counts contended acquisitions that waited less than 2^i
+  // microseconds; the last bucket also collects all longer waits.
+  intptr_t wait_time_histogram(intptr_t bucket) const {
+    ASSERT((bucket >= 0) && (bucket < kNumWaitTimeBuckets));
+    return wait_time_histogram_[bucket];
+  }
+
+  void RecordWait(int64_t micros);
+
+  // Returns the site registered under 'name', registering it if needed.
+  // Returns NULL if the table of sites is full.
+  static MutexContentionSite* Register(const char* name);
+
+  static intptr_t NumSites();
+  static MutexContentionSite* SiteAt(intptr_t index);
+
+ private:
+  static const intptr_t kMaxSites = 64;
+
+  const char* name_;
+  intptr_t contended_count_;
+  intptr_t wait_micros_;
+  uword max_wait_micros_;
+  intptr_t wait_time_histogram_[kNumWaitTimeBuckets];
+
+  static MutexContentionSite sites_[kMaxSites];
+  static uword num_sites_;
+  static uword sites_lock_;
+};
+
+
 class Mutex {
  public:
-  Mutex();
+  // A contended Lock spins briefly before blocking. Under
+  // --profile_mutex_contention named mutexes report their contention to the
+  // MutexContentionSite registered for 'name'.
+  explicit Mutex(const char* name = NULL);
   ~Mutex();
 
   void Lock();
@@ -282,7 +329,13 @@ class Mutex {
 #endif
 
  private:
+  // Spins on TryLock for up to --mutex_spin_count iterations before parking
+  // the thread in LockBlocking.
+  void LockContended();
+  void LockBlocking();
+
   MutexData data_;
+  MutexContentionSite* site_;
 #if defined(DEBUG)
   ThreadId owner_;
 #endif  // defined(DEBUG)
@@ -213,7 +213,8 @@ void OSThread::GetThreadCpuUsage(ThreadId thread_id, int64_t* cpu_usage) {
 }
 
 
-Mutex::Mutex() {
+Mutex::Mutex(const char* name)
+    : site_((name != NULL) ? MutexContentionSite::Register(name) : NULL) {
   pthread_mutexattr_t attr;
   int result = pthread_mutexattr_init(&attr);
   VALIDATE_PTHREAD_RESULT(result);
@@ -250,6 +251,13 @@ Mutex::~Mutex() {
 
 
 void Mutex::Lock() {
+  if (!TryLock()) {
+    LockContended();
+  }
+}
+
+
+void Mutex::LockBlocking() {
   int result = pthread_mutex_lock(data_.mutex());
   // Specifically check for dead lock to help debugging.
   ASSERT(result != EDEADLK);
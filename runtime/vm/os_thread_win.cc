@@ -213,7 +213,8 @@ void OSThread::SetThreadLocal(ThreadLocalKey key, uword value) {
 }
 
 
-Mutex::Mutex() {
+Mutex::Mutex(const char* name)
+    : site_((name != NULL) ? MutexContentionSite::Register(name) : NULL) {
   // Allocate unnamed semaphore with initial count 1 and max count 1.
   data_.semaphore_ = CreateSemaphore(NULL, 1, 1, NULL);
   if (data_.semaphore_ == NULL) {
@@ -236,6 +237,13 @@ Mutex::~Mutex() {
 
 
 void Mutex::Lock() {
+  if (!TryLock()) {
+    LockContended();
+  }
+}
+
+
+void Mutex::LockBlocking() {
   DWORD result = WaitForSingleObject(data_.semaphore_, INFINITE);
   if (result != WAIT_OBJECT_0) {
     FATAL1("Mutex lock failed %d", GetLastError());
@@ -150,7 +150,7 @@ PageSpace::PageSpace(Heap* heap,
                      intptr_t max_external_in_words)
     : freelist_(),
       heap_(heap),
-      pages_lock_(new Mutex()),
+      pages_lock_(new Mutex("PageSpace")),
       pages_(NULL),
       pages_tail_(NULL),
       exec_pages_(NULL),
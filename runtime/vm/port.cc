@@ -289,7 +289,7 @@ Isolate* PortMap::GetIsolate(Dart_Port id) {
 
 
 void PortMap::InitOnce() {
-  mutex_ = new Mutex();
+  mutex_ = new Mutex("PortMap");
   prng_ = new Random();
 
   static const intptr_t kInitialCapacity = 8;
@@ -4,6 +4,7 @@
 
 #include "vm/precompiler.h"
 
+#include "vm/bit_vector.h"
 #include "vm/cha.h"
 #include "vm/code_patcher.h"
 #include "vm/compiler.h"
@@ -11,10 +12,12 @@
 #include "vm/isolate.h"
 #include "vm/log.h"
 #include "vm/longjump.h"
+#include "vm/megamorphic_cache_table.h"
 #include "vm/object.h"
 #include "vm/object_store.h"
 #include "vm/resolver.h"
 #include "vm/symbols.h"
+#include "vm/version.h"
 
 namespace dart {
 
@@ -28,7 +31,15 @@ DEFINE_FLAG(bool, collect_dynamic_function_names, false,
     "In precompilation collects all dynamic function names in order to"
     " identify unique targets");
 DEFINE_FLAG(bool, print_unique_targets, false, "Print unique dynaic targets");
+DEFINE_FLAG(int, precompiler_rounds, 1,
+    "Number of precompiler rounds. Rounds after the first use the classes "
+    "allocated in the previous round to find more unique dynamic targets.");
 DEFINE_FLAG(bool, trace_precompiler, false, "Trace precompiler.");
+DEFINE_FLAG(bool, print_precompiled_fingerprints, false,
+    "Print the snapshot version and the source fingerprint and code size of "
+    "every precompiled function.");
+
+DECLARE_FLAG(bool, use_dispatch_table);
 
 
 static void Jump(const Error& error) {
@@ -64,6 +75,10 @@ Precompiler::Precompiler(Thread* thread, bool reset_fields) :
     selector_count_(0),
     dropped_function_count_(0),
     dropped_field_count_(0),
+    unique_target_count_(0),
+    scanned_selector_count_(-1),
+    scanned_class_count_(-1),
+    allocated_cids_(NULL),
     libraries_(GrowableObjectArray::Handle(I->object_store()->libraries())),
     pending_functions_(
         GrowableObjectArray::Handle(GrowableObjectArray::New())),
@@ -86,8 +101,9 @@ void Precompiler::DoCompileAll(
     // because their class hasn't been finalized yet.
     FinalizeAllClasses();
 
-    const intptr_t kPrecompilerRounds = 1;
-    for (intptr_t round = 0; round < kPrecompilerRounds; round++) {
+    const intptr_t precompiler_rounds = Utils::Maximum(1,
+        FLAG_precompiler_rounds);
+    for (intptr_t round = 0; round < precompiler_rounds; round++) {
       if (FLAG_trace_precompiler) {
         OS::Print("Precompiler round %" Pd "\n", round);
       }
@@ -121,10 +137,18 @@ void Precompiler::DoCompileAll(
     DropUncompiledFunctions();
     DropFields();
 
+    if (FLAG_print_precompiled_fingerprints) {
+      PrintFingerprints();
+    }
+
     // TODO(rmacnak): DropEmptyClasses();
 
     BindStaticCalls();
 
+    if (FLAG_use_dispatch_table) {
+      MegamorphicCacheTable::BuildDispatchTable(I);
+    }
+
     DedupStackmaps();
     DedupStackmapLists();
 
@@ -138,11 +162,12 @@ void Precompiler::DoCompileAll(
 
   if (FLAG_trace_precompiler) {
     THR_Print("Precompiled %" Pd " functions, %" Pd " dynamic types,"
-              " %" Pd " dynamic selectors.\n Dropped %" Pd " functions, %" Pd
-              " fields, %" Pd " symbols.\n",
+              " %" Pd " dynamic selectors, %" Pd " unique dynamic targets.\n"
+              " Dropped %" Pd " functions, %" Pd " fields, %" Pd " symbols.\n",
               function_count_,
               class_count_,
               selector_count_,
+              unique_target_count_,
               dropped_function_count_,
               dropped_field_count_,
               dropped_symbols_count);
@@ -647,6 +672,16 @@ void Precompiler::AddInstantiatedClass(const Class& cls) {
 
 
 void Precompiler::CheckForNewDynamicFunctions() {
+  // The functions found here only depend on the sent selectors and the
+  // allocated classes.  Skip the scan over all classes if neither changed
+  // since the last scan.
+  if ((selector_count_ == scanned_selector_count_) &&
+      (class_count_ == scanned_class_count_)) {
+    return;
+  }
+  scanned_selector_count_ = selector_count_;
+  scanned_class_count_ = class_count_;
+
   Library& lib = Library::Handle(Z);
   Class& cls = Class::Handle(Z);
   Array& functions = Array::Handle(Z);
@@ -682,7 +717,6 @@ void Precompiler::CheckForNewDynamicFunctions() {
         // Handle the implicit call type conversions.
         if (Field::IsGetterName(selector)) {
           selector2 = Field::NameFromGetter(selector);
-          selector3 = Symbols::Lookup(selector2);
           if (IsSent(selector2)) {
             // Call-through-getter.
             // Function is get:foo and somewhere foo is called.
@@ -824,6 +858,12 @@ void Precompiler::CollectDynamicFunctionNames() {
       if (cls.IsDynamicClass()) {
         continue;  // class 'dynamic' is in the read-only VM isolate.
       }
+      if ((allocated_cids_ != NULL) && !allocated_cids_->Contains(cls.id())) {
+        // No instance of this class or of any of its subclasses was
+        // allocated in the previous round, so none of its methods can be
+        // the target of a dynamic call.
+        continue;
+      }
       functions = cls.functions();
       for (intptr_t j = 0; j < functions.Length(); j++) {
         function ^= functions.At(j);
@@ -862,7 +902,10 @@ void Precompiler::CollectDynamicFunctionNames() {
     if (farray.Length() == 1) {
       function ^= farray.At(0);
       cls = function.Owner();
-      if (!CHA::IsImplemented(cls) && !CHA::HasSubclasses(cls)) {
+      const bool has_subclasses = (allocated_cids_ != NULL)
+          ? HasAllocatedSubclasses(cls)
+          : CHA::HasSubclasses(cls);
+      if (!CHA::IsImplemented(cls) && !has_subclasses) {
         functions_set.Insert(function);
       }
     }
@@ -879,12 +922,33 @@ void Precompiler::CollectDynamicFunctionNames() {
         functions_set.NumOccupied(), table.NumOccupied());
   }
 
+  unique_target_count_ = functions_set.NumOccupied();
   isolate()->object_store()->set_unique_dynamic_targets(
       functions_set.Release());
   table.Release();
 }
 
 
+// Since AddInstantiatedClass also marks all superclasses as allocated, it is
+// sufficient to check the direct subclasses.
+bool Precompiler::HasAllocatedSubclasses(const Class& cls) {
+  ASSERT(allocated_cids_ != NULL);
+  const GrowableObjectArray& subclasses =
+      GrowableObjectArray::Handle(Z, cls.direct_subclasses());
+  if (subclasses.IsNull()) {
+    return false;
+  }
+  Class& subclass = Class::Handle(Z);
+  for (intptr_t i = 0; i < subclasses.Length(); i++) {
+    subclass ^= subclasses.At(i);
+    if (allocated_cids_->Contains(subclass.id())) {
+      return true;
+    }
+  }
+  return false;
+}
+
+
 void Precompiler::GetUniqueDynamicTarget(Isolate* isolate,
                                          const String& fname,
                                          Object* function) {
@@ -1170,6 +1234,52 @@ void Precompiler::DedupStackmapLists() {
 }
 
 
+// Prints the snapshot version followed by one line per compiled function
+// with source:
+//   # snapshot <version hash>
+//   <fingerprint> <code size> <qualified name>
+// Two runs can be compared to find the functions whose source changed. This
+// is not a key for reusing compiled code: the code also depends on the class
+// hierarchy and on the code of inlined functions, which are not recorded
+// since precompiled code is never invalidated.
+void Precompiler::PrintFingerprints() {
+  class PrintFingerprintVisitor : public FunctionVisitor {
+   public:
+    explicit PrintFingerprintVisitor(Zone* zone)
+        : code_(Code::Handle(zone)) { }
+
+    void VisitFunction(const Function& function) {
+      if (!function.HasCode()) {
+        return;
+      }
+      switch (function.kind()) {
+        case RawFunction::kRegularFunction:
+        case RawFunction::kClosureFunction:
+        case RawFunction::kGetterFunction:
+        case RawFunction::kSetterFunction:
+        case RawFunction::kConstructor:
+          break;
+        default:
+          // Synthesized functions have no source of their own.
+          return;
+      }
+      code_ = function.CurrentCode();
+      THR_Print("%08x %" Pd " %s\n",
+                function.SourceFingerprint(),
+                code_.Size(),
+                function.ToLibNamePrefixedQualifiedCString());
+    }
+
+   private:
+    Code& code_;
+  };
+
+  THR_Print("# snapshot %s\n", Version::SnapshotString());
+  PrintFingerprintVisitor visitor(Z);
+  VisitFunctions(&visitor);
+}
+
+
 void Precompiler::VisitFunctions(FunctionVisitor* visitor) {
   Library& lib = Library::Handle(Z);
   Class& cls = Class::Handle(Z);
@@ -1251,6 +1361,8 @@ void Precompiler::ResetPrecompilerState() {
   function_count_ = 0;
   class_count_ = 0;
   selector_count_ = 0;
+  scanned_selector_count_ = -1;
+  scanned_class_count_ = -1;
   dropped_function_count_ = 0;
   ASSERT(pending_functions_.Length() == 0);
   sent_selectors_.Clear();
@@ -1259,6 +1371,10 @@ void Precompiler::ResetPrecompilerState() {
   Library& lib = Library::Handle(Z);
   Class& cls = Class::Handle(Z);
 
+  // Remember the classes allocated in this round.  Reachability in the next
+  // round can only shrink, so they are a sound approximation of the receiver
+  // classes of the next round.
+  allocated_cids_ = new(Z) BitVector(Z, I->class_table()->NumCids());
   for (intptr_t i = 0; i < libraries_.Length(); i++) {
     lib ^= libraries_.At(i);
     ClassDictionaryIterator it(lib, ClassDictionaryIterator::kIteratePrivate);
@@ -1267,6 +1383,9 @@ void Precompiler::ResetPrecompilerState() {
       if (cls.IsDynamicClass()) {
         continue;  // class 'dynamic' is in the read-only VM isolate.
       }
+      if (cls.is_allocated()) {
+        allocated_cids_->Add(cls.id());
+      }
       cls.set_is_allocated(false);
     }
   }
@@ -12,6 +12,7 @@
 namespace dart {
 
 // Forward declarations.
+class BitVector;
 class Class;
 class Error;
 class Field;
@@ -182,6 +183,7 @@ class Precompiler : public ValueObject {
   void DropUncompiledFunctions();
   void DropFields();
   void CollectDynamicFunctionNames();
+  bool HasAllocatedSubclasses(const Class& cls);
   void BindStaticCalls();
   void DedupStackmaps();
   void DedupStackmapLists();
@@ -194,6 +196,7 @@ class Precompiler : public ValueObject {
   };
 
   void VisitFunctions(FunctionVisitor* visitor);
+  void PrintFingerprints();
 
   void FinalizeAllClasses();
 
@@ -213,6 +216,16 @@ class Precompiler : public ValueObject {
   intptr_t selector_count_;
   intptr_t dropped_function_count_;
   intptr_t dropped_field_count_;
+  intptr_t unique_target_count_;
+  // Values of selector_count_ and class_count_ at the last scan for new
+  // dynamic functions.
+  intptr_t scanned_selector_count_;
+  intptr_t scanned_class_count_;
+
+  // Classes allocated in the previous precompiler round, or NULL during the
+  // first round.  Used to restrict the search for unique dynamic targets to
+  // methods that can actually be invoked.
+  BitVector* allocated_cids_;
 
   const GrowableObjectArray& libraries_;
   const GrowableObjectArray& pending_functions_;
@@ -1450,8 +1450,9 @@ class RawMegamorphicCache : public RawObject {
   RawSmi* mask_;
   RawString* target_name_;     // Name of target function.
   RawArray* args_descriptor_;  // Arguments descriptor.
+  RawSmi* dispatch_offset_;    // Row offset in the dispatch table, 0 if none.
   RawObject** to() {
-    return reinterpret_cast<RawObject**>(&ptr()->args_descriptor_);
+    return reinterpret_cast<RawObject**>(&ptr()->dispatch_offset_);
   }
 
   int32_t filled_entry_count_;
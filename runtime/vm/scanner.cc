@@ -935,7 +935,14 @@ void Scanner::ScanTo(intptr_t token_index) {
 
 
 const Scanner::GrowableTokenStream& Scanner::GetStream() {
-  GrowableTokenStream* ts = new(Z) GrowableTokenStream(128);
+  // Size the token stream from the source length so that scanning a large
+  // script does not repeatedly grow and copy the stream in the zone.
+  const intptr_t kMinInitialCapacity = 128;
+  const intptr_t kCharactersPerTokenEstimate = 6;
+  const intptr_t initial_capacity =
+      Utils::Maximum(kMinInitialCapacity,
+                     source_length_ / kCharactersPerTokenEstimate);
+  GrowableTokenStream* ts = new(Z) GrowableTokenStream(initial_capacity);
   ScanAll(ts);
   if (FLAG_print_tokens) {
     Scanner::PrintTokens(*ts);
@@ -41,6 +41,7 @@ namespace dart {
 #define Z (T->zone())
 
 
+DECLARE_FLAG(bool, profile_mutex_contention);
 DECLARE_FLAG(bool, trace_service);
 DECLARE_FLAG(bool, trace_service_pause_events);
 DEFINE_FLAG(charp, vm_name, "vm",
@@ -2485,6 +2486,82 @@ static bool GetCallSiteData(Thread* thread, JSONStream* js) {
 }
 
 
+static const MethodParameter* get_compiler_profile_params[] = {
+  RUNNABLE_ISOLATE_PARAMETER,
+  new UIntParameter("limit", false),
+  NULL,
+};
+
+
+static bool GetCompilerProfile(Thread* thread, JSONStream* js) {
+  const char* limit_param = js->LookupParam("limit");
+  intptr_t limit = -1;
+  if (limit_param != NULL) {
+    limit = UIntParameter::Parse(limit_param);
+  }
+  CompilerProfile::PrintJSON(thread->isolate(), js, limit);
+  return true;
+}
+
+
+static const MethodParameter* get_mutex_contention_params[] = {
+  NO_ISOLATE_PARAMETER,
+  new UIntParameter("limit", false),
+  NULL,
+};
+
+
+static int CompareMutexContentionSites(MutexContentionSite* const* a,
+                                       MutexContentionSite* const* b) {
+  // Most contended (by total wait time) first.
+  const intptr_t a_wait = (*a)->wait_micros();
+  const intptr_t b_wait = (*b)->wait_micros();
+  if (a_wait > b_wait) {
+    return -1;
+  } else if (a_wait < b_wait) {
+    return 1;
+  }
+  return 0;
+}
+
+
+static bool GetMutexContention(Thread* thread, JSONStream* js) {
+  const char* limit_param = js->LookupParam("limit");
+  intptr_t limit = -1;
+  if (limit_param != NULL) {
+    limit = UIntParameter::Parse(limit_param);
+  }
+  GrowableArray<MutexContentionSite*> sites;
+  const intptr_t num_sites = MutexContentionSite::NumSites();
+  for (intptr_t i = 0; i < num_sites; i++) {
+    MutexContentionSite* site = MutexContentionSite::SiteAt(i);
+    if (site->contended_count() > 0) {
+      sites.Add(site);
+    }
+  }
+  sites.Sort(CompareMutexContentionSites);
+  if ((limit >= 0) && (limit < sites.length())) {
+    sites.TruncateTo(limit);
+  }
+  JSONObject jsobj(js);
+  jsobj.AddProperty("type", "_MutexContention");
+  jsobj.AddProperty("enabled", FLAG_profile_mutex_contention);
+  JSONArray jssites(&jsobj, "sites");
+  for (intptr_t i = 0; i < sites.length(); i++) {
+    MutexContentionSite* site = sites[i];
+    JSONObject jssite(&jssites);
+    jssite.AddProperty("name", site->name());
+    jssite.AddProperty("contendedCount", site->contended_count());
+    jssite.AddProperty("waitMicros", site->wait_micros());
+    jssite.AddProperty("maxWaitMicros", site->max_wait_micros());
+    JSONArray histogram(&jssite, "waitTimeHistogram");
+    for (intptr_t j = 0; j < MutexContentionSite::kNumWaitTimeBuckets; j++) {
+      histogram.AddValue(site->wait_time_histogram(j));
+    }
+  }
+  return true;
+}
+
 static bool AddBreakpointCommon(Thread* thread,
                                 JSONStream* js,
                                 const String& script_uri) {
@@ -3858,6 +3935,8 @@ static const ServiceMethodDescriptor service_methods_[] = {
     get_call_site_data_params },
   { "getClassList", GetClassList,
     get_class_list_params },
+  { "_getCompilerProfile", GetCompilerProfile,
+    get_compiler_profile_params },
   { "_getCoverage", GetCoverage,
     get_coverage_params },
   { "_getCpuProfile", GetCpuProfile,
@@ -3878,6 +3957,8 @@ static const ServiceMethodDescriptor service_methods_[] = {
     get_isolate_metric_params },
   { "_getIsolateMetricList", GetIsolateMetricList,
     get_isolate_metric_list_params },
+  { "_getMutexContention", GetMutexContention,
+    get_mutex_contention_params },
   { "getObject", GetObject,
     get_object_params },
   { "_getObjectByAddress", GetObjectByAddress,
@@ -27,6 +27,9 @@ DEFINE_FLAG(uint64_t, trace_sim_after, ULLONG_MAX,
             "Trace simulator execution after instruction count reached.");
 DEFINE_FLAG(uint64_t, stop_sim_at, ULLONG_MAX,
             "Instruction address or instruction count to stop simulator at.");
+DEFINE_FLAG(bool, print_sim_stats, false,
+            "Print simulator execution statistics when a simulator is "
+            "destroyed.");
 
 
 // This macro provides a platform independent use of sscanf. The reason for
@@ -755,6 +758,14 @@ Simulator::Simulator() {
   break_instr_ = 0;
   last_setjmp_buffer_ = NULL;
   top_exit_frame_info_ = 0;
+  decode_cache_ = new DecodeCacheEntry[kDecodeCacheSize];
+  for (intptr_t i = 0; i < kDecodeCacheSize; i++) {
+    decode_cache_[i].pc = 0;
+    decode_cache_[i].instr_bits = 0;
+    decode_cache_[i].handler = NULL;
+    decode_cache_[i].count = 0;
+  }
+  decode_cache_misses_ = 0;
 
   // Setup architecture state.
   // All registers are initialized to zero to start with.
@@ -782,6 +793,10 @@ Simulator::Simulator() {
 
 
 Simulator::~Simulator() {
+  if (FLAG_print_sim_stats) {
+    PrintStats();
+  }
+  delete[] decode_cache_;
   delete[] stack_;
   Isolate* isolate = Isolate::Current();
   if (isolate != NULL) {
@@ -1493,21 +1508,6 @@ void Simulator::DecodePCRel(Instr* instr) {
 }
 
 
-void Simulator::DecodeDPImmediate(Instr* instr) {
-  if (instr->IsMoveWideOp()) {
-    DecodeMoveWide(instr);
-  } else if (instr->IsAddSubImmOp()) {
-    DecodeAddSubImm(instr);
-  } else if (instr->IsLogicalImmOp()) {
-    DecodeLogicalImm(instr);
-  } else if (instr->IsPCRelOp()) {
-    DecodePCRel(instr);
-  } else {
-    UnimplementedInstruction(instr);
-  }
-}
-
-
 void Simulator::DecodeCompareAndBranch(Instr* instr) {
   const int op = instr->Bit(24);
   const Register rt = instr->RtField();
@@ -1825,27 +1825,6 @@ void Simulator::DecodeUnconditionalBranchReg(Instr* instr) {
 }
 
 
-void Simulator::DecodeCompareBranch(Instr* instr) {
-  if (instr->IsCompareAndBranchOp()) {
-    DecodeCompareAndBranch(instr);
-  } else if (instr->IsConditionalBranchOp()) {
-    DecodeConditionalBranch(instr);
-  } else if (instr->IsExceptionGenOp()) {
-    DecodeExceptionGen(instr);
-  } else if (instr->IsSystemOp()) {
-    DecodeSystem(instr);
-  } else if (instr->IsTestAndBranchOp()) {
-    DecodeTestAndBranch(instr);
-  } else if (instr->IsUnconditionalBranchOp()) {
-    DecodeUnconditionalBranch(instr);
-  } else if (instr->IsUnconditionalBranchRegOp()) {
-    DecodeUnconditionalBranchReg(instr);
-  } else {
-    UnimplementedInstruction(instr);
-  }
-}
-
-
 void Simulator::DecodeLoadStoreReg(Instr* instr) {
   // Calculate the address.
   const Register rn = instr->RnField();
@@ -2156,19 +2135,6 @@ void Simulator::DecodeLoadRegLiteral(Instr* instr) {
 }
 
 
-void Simulator::DecodeLoadStore(Instr* instr) {
-  if (instr->IsLoadStoreRegOp()) {
-    DecodeLoadStoreReg(instr);
-  } else if (instr->IsLoadStoreRegPairOp()) {
-    DecodeLoadStoreRegPair(instr);
-  } else if (instr->IsLoadRegLiteralOp()) {
-    DecodeLoadRegLiteral(instr);
-  } else {
-    UnimplementedInstruction(instr);
-  }
-}
-
-
 int64_t Simulator::ShiftOperand(uint8_t reg_size,
                                 int64_t value,
                                 Shift shift_type,
@@ -2664,27 +2630,6 @@ void Simulator::DecodeConditionalSelect(Instr* instr) {
 }
 
 
-void Simulator::DecodeDPRegister(Instr* instr) {
-  if (instr->IsAddSubShiftExtOp()) {
-    DecodeAddSubShiftExt(instr);
-  } else if (instr->IsAddSubWithCarryOp()) {
-    DecodeAddSubWithCarry(instr);
-  } else if (instr->IsLogicalShiftOp()) {
-    DecodeLogicalShift(instr);
-  } else if (instr->IsMiscDP1SourceOp()) {
-    DecodeMiscDP1Source(instr);
-  } else if (instr->IsMiscDP2SourceOp()) {
-    DecodeMiscDP2Source(instr);
-  } else if (instr->IsMiscDP3SourceOp()) {
-    DecodeMiscDP3Source(instr);
-  } else if (instr->IsConditionalSelectOp()) {
-    DecodeConditionalSelect(instr);
-  } else {
-    UnimplementedInstruction(instr);
-  }
-}
-
-
 void Simulator::DecodeSIMDCopy(Instr* instr) {
   const int32_t Q = instr->Bit(30);
   const int32_t op = instr->Bit(29);
@@ -3124,19 +3069,6 @@ void Simulator::DecodeSIMDTwoReg(Instr* instr) {
 }
 
 
-void Simulator::DecodeDPSimd1(Instr* instr) {
-  if (instr->IsSIMDCopyOp()) {
-    DecodeSIMDCopy(instr);
-  } else if (instr->IsSIMDThreeSameOp()) {
-    DecodeSIMDThreeSame(instr);
-  } else if (instr->IsSIMDTwoRegOp()) {
-    DecodeSIMDTwoReg(instr);
-  } else {
-    UnimplementedInstruction(instr);
-  }
-}
-
-
 void Simulator::DecodeFPImm(Instr* instr) {
   if ((instr->Bit(31) != 0) || (instr->Bit(29) != 0) || (instr->Bit(23) != 0) ||
       (instr->Bits(5, 5) != 0)) {
@@ -3331,28 +3263,141 @@ void Simulator::DecodeFPCompare(Instr* instr) {
 }
 
 
-void Simulator::DecodeFP(Instr* instr) {
-  if (instr->IsFPImmOp()) {
-    DecodeFPImm(instr);
-  } else if (instr->IsFPIntCvtOp()) {
-    DecodeFPIntCvt(instr);
-  } else if (instr->IsFPOneSourceOp()) {
-    DecodeFPOneSource(instr);
-  } else if (instr->IsFPTwoSourceOp()) {
-    DecodeFPTwoSource(instr);
-  } else if (instr->IsFPCompareOp()) {
-    DecodeFPCompare(instr);
-  } else {
-    UnimplementedInstruction(instr);
+// Walks the decode tree for 'instr' and returns the handler that executes it.
+Simulator::DecodeHandler Simulator::ResolveDecodeHandler(Instr* instr) {
+  if (instr->IsDPImmediateOp()) {
+    if (instr->IsMoveWideOp()) {
+      return &Simulator::DecodeMoveWide;
+    } else if (instr->IsAddSubImmOp()) {
+      return &Simulator::DecodeAddSubImm;
+    } else if (instr->IsLogicalImmOp()) {
+      return &Simulator::DecodeLogicalImm;
+    } else if (instr->IsPCRelOp()) {
+      return &Simulator::DecodePCRel;
+    }
+  } else if (instr->IsCompareBranchOp()) {
+    if (instr->IsCompareAndBranchOp()) {
+      return &Simulator::DecodeCompareAndBranch;
+    } else if (instr->IsConditionalBranchOp()) {
+      return &Simulator::DecodeConditionalBranch;
+    } else if (instr->IsExceptionGenOp()) {
+      return &Simulator::DecodeExceptionGen;
+    } else if (instr->IsSystemOp()) {
+      return &Simulator::DecodeSystem;
+    } else if (instr->IsTestAndBranchOp()) {
+      return &Simulator::DecodeTestAndBranch;
+    } else if (instr->IsUnconditionalBranchOp()) {
+      return &Simulator::DecodeUnconditionalBranch;
+    } else if (instr->IsUnconditionalBranchRegOp()) {
+      return &Simulator::DecodeUnconditionalBranchReg;
+    }
+  } else if (instr->IsLoadStoreOp()) {
+    if (instr->IsLoadStoreRegOp()) {
+      return &Simulator::DecodeLoadStoreReg;
+    } else if (instr->IsLoadStoreRegPairOp()) {
+      return &Simulator::DecodeLoadStoreRegPair;
+    } else if (instr->IsLoadRegLiteralOp()) {
+      return &Simulator::DecodeLoadRegLiteral;
+    }
+  } else if (instr->IsDPRegisterOp()) {
+    if (instr->IsAddSubShiftExtOp()) {
+      return &Simulator::DecodeAddSubShiftExt;
+    } else if (instr->IsAddSubWithCarryOp()) {
+      return &Simulator::DecodeAddSubWithCarry;
+    } else if (instr->IsLogicalShiftOp()) {
+      return &Simulator::DecodeLogicalShift;
+    } else if (instr->IsMiscDP1SourceOp()) {
+      return &Simulator::DecodeMiscDP1Source;
+    } else if (instr->IsMiscDP2SourceOp()) {
+      return &Simulator::DecodeMiscDP2Source;
+    } else if (instr->IsMiscDP3SourceOp()) {
+      return &Simulator::DecodeMiscDP3Source;
+    } else if (instr->IsConditionalSelectOp()) {
+      return &Simulator::DecodeConditionalSelect;
+    }
+  } else if (instr->IsDPSimd1Op()) {
+    if (instr->IsSIMDCopyOp()) {
+      return &Simulator::DecodeSIMDCopy;
+    } else if (instr->IsSIMDThreeSameOp()) {
+      return &Simulator::DecodeSIMDThreeSame;
+    } else if (instr->IsSIMDTwoRegOp()) {
+      return &Simulator::DecodeSIMDTwoReg;
+    }
+  } else if (instr->IsDPSimd2Op()) {
+    if (instr->IsFPOp()) {
+      if (instr->IsFPImmOp()) {
+        return &Simulator::DecodeFPImm;
+      } else if (instr->IsFPIntCvtOp()) {
+        return &Simulator::DecodeFPIntCvt;
+      } else if (instr->IsFPOneSourceOp()) {
+        return &Simulator::DecodeFPOneSource;
+      } else if (instr->IsFPTwoSourceOp()) {
+        return &Simulator::DecodeFPTwoSource;
+      } else if (instr->IsFPCompareOp()) {
+        return &Simulator::DecodeFPCompare;
+      }
+    }
   }
+  return &Simulator::UnimplementedInstruction;
 }
 
 
-void Simulator::DecodeDPSimd2(Instr* instr) {
-  if (instr->IsFPOp()) {
-    DecodeFP(instr);
-  } else {
-    UnimplementedInstruction(instr);
+// Returns the handler for 'instr' from the decoded instruction cache,
+// walking the decode tree only on a miss. Entries are validated against the
+// instruction bits, so patched code is simply decoded again.
+Simulator::DecodeHandler Simulator::LookupDecodeHandler(Instr* instr) {
+  const uword pc = reinterpret_cast<uword>(instr);
+  const int32_t bits = instr->InstructionBits();
+  DecodeCacheEntry* entry =
+      &decode_cache_[(pc >> 2) & (kDecodeCacheSize - 1)];
+  if ((entry->pc == pc) && (entry->instr_bits == bits)) {
+    if (FLAG_print_sim_stats) {
+      entry->count++;
+    }
+    return entry->handler;
+  }
+  decode_cache_misses_++;
+  entry->pc = pc;
+  entry->instr_bits = bits;
+  entry->handler = ResolveDecodeHandler(instr);
+  entry->count = 1;
+  return entry->handler;
+}
+
+
+void Simulator::PrintStats() {
+  OS::Print("Simulator executed %" Pu64 " instructions, "
+            "%" Pu64 " decode cache misses\n",
+            icount_, decode_cache_misses_);
+  // Report the hottest instructions still in the decode cache.
+  const intptr_t kNumHottest = 20;
+  DecodeCacheEntry* hottest[kNumHottest];
+  intptr_t num_hottest = 0;
+  for (intptr_t i = 0; i < kDecodeCacheSize; i++) {
+    DecodeCacheEntry* entry = &decode_cache_[i];
+    if (entry->count == 0) {
+      continue;
+    }
+    // Insertion into the list of hottest entries, sorted by count.
+    intptr_t j = num_hottest;
+    if (j == kNumHottest) {
+      if (hottest[j - 1]->count >= entry->count) {
+        continue;
+      }
+      j--;
+    } else {
+      num_hottest++;
+    }
+    while ((j > 0) && (hottest[j - 1]->count < entry->count)) {
+      hottest[j] = hottest[j - 1];
+      j--;
+    }
+    hottest[j] = entry;
+  }
+  for (intptr_t i = 0; i < num_hottest; i++) {
+    OS::Print("%12" Pu64 " ", hottest[i]->count);
+    Disassembler::Disassemble(hottest[i]->pc,
+                              hottest[i]->pc + Instr::kInstrSize);
   }
 }
 
@@ -3367,21 +3412,8 @@ void Simulator::InstructionDecode(Instr* instr) {
     Disassembler::Disassemble(start, end);
   }
 
-  if (instr->IsDPImmediateOp()) {
-    DecodeDPImmediate(instr);
-  } else if (instr->IsCompareBranchOp()) {
-    DecodeCompareBranch(instr);
-  } else if (instr->IsLoadStoreOp()) {
-    DecodeLoadStore(instr);
-  } else if (instr->IsDPRegisterOp()) {
-    DecodeDPRegister(instr);
-  } else if (instr->IsDPSimd1Op()) {
-    DecodeDPSimd1(instr);
-  } else if (instr->IsDPSimd2Op()) {
-    DecodeDPSimd2(instr);
-  } else {
-    UnimplementedInstruction(instr);
-  }
+  DecodeHandler handler = LookupDecodeHandler(instr);
+  (this->*handler)(instr);
 
   if (!pc_modified_) {
     set_pc(reinterpret_cast<int64_t>(instr) + Instr::kInstrSize);
@@ -250,12 +250,58 @@ class Simulator {
 
   void DoRedirectedCall(Instr* instr);
 
-  // Decode instructions.
+  // Decode instructions. ResolveDecodeHandler selects one of the handlers
+  // below for each instruction.
   void InstructionDecode(Instr* instr);
-  #define DECODE_OP(op)                                                        \
-    void Decode##op(Instr* instr);
-  APPLY_OP_LIST(DECODE_OP)
-  #undef DECODE_OP
+  void DecodeMoveWide(Instr* instr);
+  void DecodeAddSubImm(Instr* instr);
+  void DecodeLogicalImm(Instr* instr);
+  void DecodePCRel(Instr* instr);
+  void DecodeCompareAndBranch(Instr* instr);
+  void DecodeConditionalBranch(Instr* instr);
+  void DecodeExceptionGen(Instr* instr);
+  void DecodeSystem(Instr* instr);
+  void DecodeTestAndBranch(Instr* instr);
+  void DecodeUnconditionalBranch(Instr* instr);
+  void DecodeUnconditionalBranchReg(Instr* instr);
+  void DecodeLoadStoreReg(Instr* instr);
+  void DecodeLoadStoreRegPair(Instr* instr);
+  void DecodeLoadRegLiteral(Instr* instr);
+  void DecodeAddSubShiftExt(Instr* instr);
+  void DecodeAddSubWithCarry(Instr* instr);
+  void DecodeLogicalShift(Instr* instr);
+  void DecodeMiscDP1Source(Instr* instr);
+  void DecodeMiscDP2Source(Instr* instr);
+  void DecodeMiscDP3Source(Instr* instr);
+  void DecodeConditionalSelect(Instr* instr);
+  void DecodeSIMDCopy(Instr* instr);
+  void DecodeSIMDThreeSame(Instr* instr);
+  void DecodeSIMDTwoReg(Instr* instr);
+  void DecodeFPImm(Instr* instr);
+  void DecodeFPIntCvt(Instr* instr);
+  void DecodeFPOneSource(Instr* instr);
+  void DecodeFPTwoSource(Instr* instr);
+  void DecodeFPCompare(Instr* instr);
+
+  // Decoded instruction cache, mapping a pc to the handler executing the
+  // instruction at that pc.
+  typedef void (Simulator::*DecodeHandler)(Instr* instr);
+  struct DecodeCacheEntry {
+    uword pc;
+    int32_t instr_bits;
+    DecodeHandler handler;
+    uint64_t count;  // Executions since filled, with --print_sim_stats.
+  };
+  static const intptr_t kDecodeCacheSize = 4096;  // Must be a power of 2.
+  DecodeCacheEntry* decode_cache_;
+  uint64_t decode_cache_misses_;
+
+  DecodeHandler ResolveDecodeHandler(Instr* instr);
+  DecodeHandler LookupDecodeHandler(Instr* instr);
+
+  // Prints the instruction count, the decode cache hit rate and the hottest
+  // cached instructions.
+  void PrintStats();
 
   // Executes ARM64 instructions until the PC reaches kEndSimulatingPC.
   void Execute();
@@ -829,7 +829,8 @@ class InstructionsWriter : public ZoneAllocated {
   int32_t GetOffsetFor(RawInstructions* instructions);
 
   void SetInstructionsCode(RawInstructions* insns, RawCode* code) {
-    for (intptr_t i = 0; i < instructions_.length(); i++) {
+    // The Code is written right after its Instructions, so search backwards.
+    for (intptr_t i = instructions_.length() - 1; i >= 0; i--) {
       if (instructions_[i].raw_insns_ == insns) {
         instructions_[i].raw_code_ = code;
         return;
@@ -11,6 +11,7 @@
 #include "vm/flow_graph_compiler.h"
 #include "vm/heap.h"
 #include "vm/instructions.h"
+#include "vm/megamorphic_cache_table.h"
 #include "vm/object_store.h"
 #include "vm/resolver.h"
 #include "vm/scavenger.h"
@@ -29,6 +30,7 @@ DECLARE_FLAG(bool, trace_optimized_ic_calls);
 DECLARE_FLAG(int, optimization_counter_threshold);
 DECLARE_FLAG(bool, support_debugger);
 DECLARE_FLAG(bool, lazy_dispatchers);
+DECLARE_FLAG(bool, use_dispatch_table);
 
 // Input parameters:
 //   RSP : points to return address.
@@ -2099,13 +2101,43 @@ void StubCode::EmitMegamorphicLookup(Assembler* assembler) {
   // RAX: class ID of the receiver (smi).
   __ movq(R10,
           FieldAddress(RBX, MegamorphicCache::arguments_descriptor_offset()));
+  Label probe_cache, done;
+  if (FLAG_use_dispatch_table) {
+    // Look at entry (class ID + selector offset) of the dispatch table. It
+    // belongs to this selector iff it is tagged with the selector's offset.
+    const intptr_t entry_size =
+        MegamorphicCacheTable::kDispatchEntryLength * kWordSize;
+    ASSERT(entry_size == 2 * kWordSize);
+    __ movq(R9, FieldAddress(RBX, MegamorphicCache::dispatch_offset_offset()));
+    __ LoadIsolate(RDI);
+    __ movq(RDI, Address(RDI, Isolate::dispatch_table_offset()));
+    // RDI: dispatch table.
+    // R9: selector offset (smi), 0 if the selector has no row.
+    __ leaq(RCX, Address(RAX, R9, TIMES_1, 0));
+    __ addq(RCX, RCX);
+    // RCX: smi index of the entry, unsigned compare also catches negatives.
+    __ cmpq(RCX, FieldAddress(RDI, Array::length_offset()));
+    __ j(ABOVE_EQUAL, &probe_cache, Assembler::kNearJump);
+    const intptr_t offset_slot = Array::data_offset() +
+        MegamorphicCacheTable::kDispatchOffsetIndex * kWordSize;
+    const intptr_t target_slot = Array::data_offset() +
+        MegamorphicCacheTable::kDispatchTargetIndex * kWordSize;
+    // RCX is a smi index of a one-word element, so TIMES_4.
+    __ cmpq(R9, FieldAddress(RDI, RCX, TIMES_4, offset_slot));
+    __ j(NOT_EQUAL, &probe_cache, Assembler::kNearJump);
+    __ movq(RAX, FieldAddress(RDI, RCX, TIMES_4, target_slot));
+    __ movq(RCX, FieldAddress(RAX, Function::entry_point_offset()));
+    __ movq(CODE_REG, FieldAddress(RAX, Function::code_offset()));
+    __ jmp(&done);
+  }
+  __ Bind(&probe_cache);
   __ movq(RDI, FieldAddress(RBX, MegamorphicCache::buckets_offset()));
   __ movq(R9, FieldAddress(RBX, MegamorphicCache::mask_offset()));
   // RDI: cache buckets array.
   // RBX: mask.
   __ movq(RCX, RAX);
 
-  Label loop, update, load_target_function;
+  Label loop, update, found;
   __ jmp(&loop);
 
   __ Bind(&update);
@@ -2118,11 +2150,11 @@ void StubCode::EmitMegamorphicLookup(Assembler* assembler) {
 
   ASSERT(kIllegalCid == 0);
   __ testq(RDX, RDX);
-  __ j(ZERO, &load_target_function, Assembler::kNearJump);
+  __ j(ZERO, &found, Assembler::kNearJump);
   __ cmpq(RDX, RAX);
   __ j(NOT_EQUAL, &update, Assembler::kNearJump);
 
-  __ Bind(&load_target_function);
+  __ Bind(&found);
   // Call the target found in the cache.  For a class id match, this is a
   // proper target for the given name and arguments descriptor.  If the
   // illegal class id was found, the target is a cache miss handler that can
@@ -2130,6 +2162,7 @@ void StubCode::EmitMegamorphicLookup(Assembler* assembler) {
   __ movq(RAX, FieldAddress(RDI, RCX, TIMES_8, base + kWordSize));
   __ movq(RCX, FieldAddress(RAX, Function::entry_point_offset()));
   __ movq(CODE_REG, FieldAddress(RAX, Function::code_offset()));
+  __ Bind(&done);
 }
 
 
@@ -135,20 +135,28 @@ RawString* ConcatString::ToSymbol() const {
 }
 
 
+// All symbols have their hash computed, and every lookup key computes its hash
+// up front, so the matchers compare hashes before comparing characters. This
+// keeps long probe sequences from doing a string comparison per probe.
 class SymbolTraits {
  public:
   static bool IsMatch(const Object& a, const Object& b) {
-    return String::Cast(a).Equals(String::Cast(b));
+    const String& a_str = String::Cast(a);
+    const String& b_str = String::Cast(b);
+    return (a_str.Hash() == b_str.Hash()) && a_str.Equals(b_str);
   }
   template<typename CharType>
   static bool IsMatch(const CharArray<CharType>& array, const Object& obj) {
-    return array.Equals(String::Cast(obj));
+    const String& str = String::Cast(obj);
+    return (array.Hash() == str.Hash()) && array.Equals(str);
   }
   static bool IsMatch(const StringSlice& slice, const Object& obj) {
-    return slice.Equals(String::Cast(obj));
+    const String& str = String::Cast(obj);
+    return (slice.Hash() == str.Hash()) && slice.Equals(str);
   }
   static bool IsMatch(const ConcatString& concat, const Object& obj) {
-    return concat.Equals(String::Cast(obj));
+    const String& str = String::Cast(obj);
+    return (concat.Hash() == str.Hash()) && concat.Equals(str);
   }
   static uword Hash(const Object& key) {
     return String::Cast(key).Hash();
@@ -425,6 +433,31 @@ void Symbols::GetStats(Isolate* isolate, intptr_t* size, intptr_t* capacity) {
 }
 
 
+void Symbols::GetProbeStats(Isolate* isolate,
+                            intptr_t* total_probes,
+                            intptr_t* max_probes) {
+  ASSERT(isolate != NULL);
+  SymbolTable table(isolate->object_store()->symbol_table());
+  String& symbol = String::Handle();
+  const intptr_t num_entries = table.NumEntries();
+  *total_probes = 0;
+  *max_probes = 0;
+  for (intptr_t i = 0; i < num_entries; i++) {
+    if (table.IsOccupied(i)) {
+      symbol ^= table.GetKey(i);
+      // The table uses linear probing, so the number of probes needed to find
+      // a symbol is its distance from its home entry, plus one.
+      const intptr_t home = static_cast<uword>(symbol.Hash()) % num_entries;
+      const intptr_t probes =
+          ((i >= home) ? (i - home) : (i + num_entries - home)) + 1;
+      *total_probes += probes;
+      *max_probes = Utils::Maximum(*max_probes, probes);
+    }
+  }
+  table.Release();
+}
+
+
 RawString* Symbols::New(const char* cstr, intptr_t len) {
   ASSERT((cstr != NULL) && (len >= 0));
   const uint8_t* utf8_array = reinterpret_cast<const uint8_t*>(cstr);
@@ -658,20 +691,35 @@ RawString* Symbols::FromCharCode(int32_t char_code) {
 }
 
 
+static void PrintProbeStats(const char* name,
+                            intptr_t size,
+                            intptr_t total_probes,
+                            intptr_t max_probes) {
+  const double average_probes =
+      (size > 0) ? (static_cast<double>(total_probes) / size) : 0.0;
+  OS::Print("%s: Average probes per symbol : %.2f\n", name, average_probes);
+  OS::Print("%s: Maximum probes per symbol : %" Pd "\n", name, max_probes);
+}
+
+
 void Symbols::DumpStats() {
   if (FLAG_dump_symbol_stats) {
     intptr_t size = -1;
     intptr_t capacity = -1;
+    intptr_t total_probes = -1;
+    intptr_t max_probes = -1;
     // First dump VM symbol table stats.
     GetStats(Dart::vm_isolate(), &size, &capacity);
+    GetProbeStats(Dart::vm_isolate(), &total_probes, &max_probes);
     OS::Print("VM Isolate: Number of symbols : %" Pd "\n", size);
     OS::Print("VM Isolate: Symbol table capacity : %" Pd "\n", capacity);
+    PrintProbeStats("VM Isolate", size, total_probes, max_probes);
     // Now dump regular isolate symbol table stats.
     GetStats(Isolate::Current(), &size, &capacity);
+    GetProbeStats(Isolate::Current(), &total_probes, &max_probes);
     OS::Print("Isolate: Number of symbols : %" Pd "\n", size);
     OS::Print("Isolate: Symbol table capacity : %" Pd "\n", capacity);
-    // TODO(koda): Consider recording growth and collision stats in HashTable,
-    // in DEBUG mode.
+    PrintProbeStats("Isolate", size, total_probes, max_probes);
   }
 }
 
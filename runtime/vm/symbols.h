@@ -639,6 +639,12 @@ class Symbols : public AllStatic {
                        intptr_t* size,
                        intptr_t* capacity);
 
+  // Computes the total and the maximum number of probes needed to look up
+  // each symbol in the symbol table of 'isolate'.
+  static void GetProbeStats(Isolate* isolate,
+                            intptr_t* total_probes,
+                            intptr_t* max_probes);
+
   template<typename StringType>
   static RawString* NewSymbol(const StringType& str);
 
@@ -13,7 +13,8 @@ DEFINE_FLAG(int, worker_timeout_millis, 5000,
             "Free workers when they have been idle for this amount of time.");
 
 ThreadPool::ThreadPool()
-  : shutting_down_(false),
+  : mutex_("ThreadPool"),
+    shutting_down_(false),
     all_workers_(NULL),
     idle_workers_(NULL),
     count_started_(0),
@@ -6,6 +6,8 @@
 
 #include "vm/isolate.h"
 #include "vm/lockers.h"
+#include "vm/log.h"
+#include "vm/os.h"
 
 namespace dart {
 
@@ -39,6 +41,7 @@ void ThreadRegistry::SafepointThreads() {
     ASSERT(remaining_ > 0);
     CheckSafepointLocked();
   }
+  const int64_t start = OS::GetCurrentMonotonicMicros();
   // Start a new round.
   in_rendezvous_ = true;
   ++round_;  // Overflows after 240+ years @ 10^9 safepoints per second.
@@ -47,12 +50,51 @@ void ThreadRegistry::SafepointThreads() {
   // We only expect this method to be called from within the isolate itself.
   ASSERT(isolate->thread_registry() == this);
   --remaining_;  // Exclude this thread from the count.
-  // Ensure the main mutator will reach a safepoint (could be running Dart).
-  if (!Thread::Current()->IsMutatorThread()) {
-    isolate->ScheduleInterrupts(Isolate::kVMInterrupt);
+  if (remaining_ > 0) {
+    // Ensure the main mutator will reach a safepoint (could be running Dart).
+    // The interrupt trips the stack limit checks that the compiler emits at
+    // function entries and loop back edges, so even a long running optimized
+    // loop polls for the rendezvous on its next iteration.
+    if (!Thread::Current()->IsMutatorThread()) {
+      isolate->ScheduleInterrupts(Isolate::kVMInterrupt);
+    }
+    while (remaining_ > 0) {
+      ml.Wait(Monitor::kNoTimeout);
+    }
   }
-  while (remaining_ > 0) {
-    ml.Wait(Monitor::kNoTimeout);
+  RecordSafepointTimeLocked(OS::GetCurrentMonotonicMicros() - start);
+}
+
+
+void ThreadRegistry::RecordSafepointTimeLocked(int64_t micros) {
+  ASSERT(micros >= 0);
+  intptr_t bucket = 0;
+  while ((bucket < (kNumSafepointTimeBuckets - 1)) &&
+         (micros >= (static_cast<int64_t>(1) << bucket))) {
+    bucket++;
+  }
+  safepoint_time_histogram_[bucket]++;
+  safepoint_count_++;
+  if (micros > safepoint_max_micros_) {
+    safepoint_max_micros_ = micros;
+  }
+}
+
+
+void ThreadRegistry::PrintSafepointStats() const {
+  THR_Print("Time to safepoint: %" Pd64 " rendezvous, max %" Pd64 " us\n",
+            safepoint_count_, safepoint_max_micros_);
+  for (intptr_t i = 0; i < kNumSafepointTimeBuckets; i++) {
+    if (safepoint_time_histogram_[i] == 0) continue;
+    if (i == (kNumSafepointTimeBuckets - 1)) {
+      THR_Print("  >= %" Pd64 " us: %" Pd64 "\n",
+                static_cast<int64_t>(1) << (i - 1),
+                safepoint_time_histogram_[i]);
+    } else {
+      THR_Print("  < %" Pd64 " us: %" Pd64 "\n",
+                static_cast<int64_t>(1) << i,
+                safepoint_time_histogram_[i]);
+    }
   }
 }
 
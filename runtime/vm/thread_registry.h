@@ -24,7 +24,13 @@ class ThreadRegistry {
         mutator_thread_(NULL),
         in_rendezvous_(false),
         remaining_(0),
-        round_(0) {}
+        round_(0),
+        safepoint_count_(0),
+        safepoint_max_micros_(0) {
+    for (intptr_t i = 0; i < kNumSafepointTimeBuckets; i++) {
+      safepoint_time_histogram_[i] = 0;
+    }
+  }
 
   ~ThreadRegistry();
 
@@ -53,6 +59,20 @@ class ThreadRegistry {
   }
 
   bool AtSafepoint() const { return in_rendezvous_; }
+
+  // Time-to-safepoint statistics, i.e. how long SafepointThreads waited for
+  // the other threads to reach their safepoint. Bucket i of the histogram
+  // counts rendezvous that took less than 2^i microseconds; the last bucket
+  // also collects everything slower.
+  static const intptr_t kNumSafepointTimeBuckets = 24;
+  int64_t safepoint_count() const { return safepoint_count_; }
+  int64_t safepoint_max_micros() const { return safepoint_max_micros_; }
+  int64_t safepoint_time_histogram(intptr_t bucket) const {
+    ASSERT((bucket >= 0) && (bucket < kNumSafepointTimeBuckets));
+    return safepoint_time_histogram_[bucket];
+  }
+  void PrintSafepointStats() const;
+
   Thread* Schedule(Isolate* isolate, bool is_mutator, bool bypass_safepoint);
   void Unschedule(Thread* thread, bool is_mutator, bool bypass_safepoint);
   void VisitObjectPointers(ObjectPointerVisitor* visitor, bool validate_frames);
@@ -71,6 +91,9 @@ class ThreadRegistry {
   // Note: Lock should be taken before this function is called.
   intptr_t CountScheduledLocked();
 
+  // Note: Lock should be taken before this function is called.
+  void RecordSafepointTimeLocked(int64_t micros);
+
   Monitor* monitor_;  // All access is synchronized through this monitor.
   Thread* active_list_;  // List of active threads in the isolate.
   Thread* free_list_;  // Free list of Thread objects that can be reused.
@@ -95,6 +118,11 @@ class ThreadRegistry {
   int64_t round_;         // Counter, to prevent missing updates to remaining_
                           // (see comments in CheckSafepointLocked).
 
+  // Time-to-safepoint statistics, updated under monitor_.
+  int64_t safepoint_count_;
+  int64_t safepoint_max_micros_;
+  int64_t safepoint_time_histogram_[kNumSafepointTimeBuckets];
+
   DISALLOW_COPY_AND_ASSIGN(ThreadRegistry);
 };
 
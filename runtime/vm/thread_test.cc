@@ -34,6 +34,38 @@ UNIT_TEST_CASE(Mutex) {
 }
 
 
+UNIT_TEST_CASE(MutexContentionSite) {
+  MutexContentionSite* site =
+      MutexContentionSite::Register("MutexContentionSiteTest");
+  EXPECT(site != NULL);
+  // Mutexes created with the same name share their lock site.
+  EXPECT_EQ(site, MutexContentionSite::Register("MutexContentionSiteTest"));
+  EXPECT_STREQ("MutexContentionSiteTest", site->name());
+  bool found = false;
+  for (intptr_t i = 0; i < MutexContentionSite::NumSites(); i++) {
+    if (MutexContentionSite::SiteAt(i) == site) {
+      found = true;
+    }
+  }
+  EXPECT(found);
+
+  EXPECT_EQ(0, site->contended_count());
+  site->RecordWait(0);
+  site->RecordWait(3);
+  site->RecordWait(1 << 20);
+  EXPECT_EQ(3, site->contended_count());
+  EXPECT_EQ(1 << 20, site->max_wait_micros());
+  EXPECT_EQ(1, site->wait_time_histogram(0));
+  EXPECT_EQ(1, site->wait_time_histogram(2));
+  EXPECT_EQ(1, site->wait_time_histogram(
+      MutexContentionSite::kNumWaitTimeBuckets - 1));
+
+  Mutex mutex("MutexContentionSiteTest");
+  mutex.Lock();
+  EXPECT_EQ(false, mutex.TryLock());
+  mutex.Unlock();
+}
+
 UNIT_TEST_CASE(Monitor) {
   // This unit test case needs a running isolate.
   Dart_CreateIsolate(
@@ -524,6 +556,25 @@ TEST_CASE(SafepointTestVM2) {
 }
 
 
+// Test that each rendezvous is accounted for in the time-to-safepoint
+// histogram.
+TEST_CASE(SafepointStats) {
+  ThreadRegistry* registry = thread->isolate()->thread_registry();
+  const int64_t initial_count = registry->safepoint_count();
+  const intptr_t kRounds = 10;
+  for (intptr_t i = 0; i < kRounds; i++) {
+    registry->SafepointThreads();
+    registry->ResumeAllThreads();
+  }
+  EXPECT_EQ(initial_count + kRounds, registry->safepoint_count());
+  int64_t histogram_total = 0;
+  for (intptr_t i = 0; i < ThreadRegistry::kNumSafepointTimeBuckets; i++) {
+    histogram_total += registry->safepoint_time_histogram(i);
+  }
+  EXPECT_EQ(registry->safepoint_count(), histogram_total);
+  EXPECT(registry->safepoint_max_micros() >= 0);
+}
+
 class AllocAndGCTask : public ThreadPool::Task {
  public:
   AllocAndGCTask(Isolate* isolate,
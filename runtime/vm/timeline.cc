@@ -771,7 +771,8 @@ IsolateTimelineEventFilter::IsolateTimelineEventFilter(
 
 
 TimelineEventRecorder::TimelineEventRecorder()
-    : async_id_(0) {
+    : lock_("TimelineEventRecorder"),
+      async_id_(0) {
 }
 
 
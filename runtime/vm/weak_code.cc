@@ -70,18 +70,23 @@ void WeakCodeReferences::DisableCode() {
   ASSERT(Compiler::allow_recompilation());
   UpdateArrayTo(Object::null_array());
   // Disable all code on stack.
-  Code& code = Code::Handle();
+  Zone* zone = Thread::Current()->zone();
+  Code& code = Code::Handle(zone);
   {
+    GrowableArray<const Code*> optimized_codes;
+    GrowableArray<uword> pcs;
     DartFrameIterator iterator;
     StackFrame* frame = iterator.NextFrame();
     while (frame != NULL) {
       code = frame->LookupDartCode();
       if (IsOptimizedCode(code_objects, code)) {
         ReportDeoptimization(code);
-        DeoptimizeAt(code, frame->pc());
+        optimized_codes.Add(&Code::ZoneHandle(zone, code.raw()));
+        pcs.Add(frame->pc());
       }
       frame = iterator.NextFrame();
     }
+    DeoptimizeAt(optimized_codes, pcs);
   }
 
   // Switch functions that use dependent code to unoptimized code.